@@ -2,80 +2,267 @@
 
 namespace IL2CPP
 {
-// 	struct CallbackHook_t
-// 	{
-// 		std::vector<void*> m_Funcs;
-// 
-// 		void** m_VFunc = nullptr;
-// 		void* m_Original = nullptr;
-// 	};
-// 
-// 	namespace Callback
-// 	{
-// 		namespace OnUpdate
-// 		{
-// 			CallbackHook_t m_CallbackHook;
-// 
-// 			void Add(void* m_pFunction) 
-// 			{ 
-// 				m_CallbackHook.m_Funcs.emplace_back(m_pFunction);
-// 			}
-// 
-// 			void __fastcall Hook(void* rcx)
-// 			{
-// 				for (void* m_Func : m_CallbackHook.m_Funcs)
-// 					reinterpret_cast<void(*)()>(m_Func)();
-// 
-// 				reinterpret_cast<void(__fastcall*)(void*)>(m_CallbackHook.m_Original)(rcx);
-// 			}
-// 		}
-// 
-// 		namespace OnLateUpdate
-// 		{
-// 			CallbackHook_t m_CallbackHook;
-// 
-// 			void Add(void* m_pFunction)
-// 			{
-// 				m_CallbackHook.m_Funcs.emplace_back(m_pFunction);
-// 			}
-// 
-// 			void __fastcall Hook(void* rcx)
-// 			{
-// 				for (void* m_Func : m_CallbackHook.m_Funcs)
-// 					reinterpret_cast<void(*)()>(m_Func)();
-// 
-// 				reinterpret_cast<void(__fastcall*)(void*)>(m_CallbackHook.m_Original)(rcx);
-// 			}
-// 		}
-// 
-// 		void Initialize()
-// 		{
-// 			void* m_IL2CPPThread = Thread::Attach(IL2CPP::Domain::Get());
-// 
-// 			// Find
-// 			void** m_MonoBehaviourVTable = *reinterpret_cast<void***>(IL2CPP::Helper::GetMonoBehaviour()->m_CachedPtr);
-// 			if (m_MonoBehaviourVTable)
-// 			{
-// #ifdef _WIN64
-// 				OnUpdate::m_CallbackHook.m_VFunc		= Utils::VTable::FindFunction(m_MonoBehaviourVTable, 99, { 0x33, 0xD2, 0xE9 }); // xor edx, edx | jmp
-// 				OnLateUpdate::m_CallbackHook.m_VFunc	= Utils::VTable::FindFunction(m_MonoBehaviourVTable, 99, { 0xBA, 0x01, 0x00, 0x00, 0x00, 0xE9 }); //  mov edx, 1 | jmp
-// #elif _WIN32
-// 				OnUpdate::m_CallbackHook.m_VFunc		= Utils::VTable::FindFunction(m_MonoBehaviourVTable, 99, { 0x6A, 0x00, 0xE8 }); // push 00 | call
-// 				OnLateUpdate::m_CallbackHook.m_VFunc	= Utils::VTable::FindFunction(m_MonoBehaviourVTable, 99, { 0x6A, 0x01, 0xE8 }); // push 01 | call
-// #endif
-// 			}
-// 
-// 			IL2CPP::Thread::Detach(m_IL2CPPThread);
-// 
-// 			// Replace (Hook)
-// 			Utils::VTable::ReplaceFunction(OnUpdate::m_CallbackHook.m_VFunc, OnUpdate::Hook, &OnUpdate::m_CallbackHook.m_Original);
-// 			Utils::VTable::ReplaceFunction(OnLateUpdate::m_CallbackHook.m_VFunc, OnLateUpdate::Hook, &OnLateUpdate::m_CallbackHook.m_Original);
-// 		}
-// 
-// 		void Uninitialize()
-// 		{
-// 			Utils::VTable::ReplaceFunction(OnUpdate::m_CallbackHook.m_VFunc, OnUpdate::m_CallbackHook.m_Original);
-// 			Utils::VTable::ReplaceFunction(OnLateUpdate::m_CallbackHook.m_VFunc, OnLateUpdate::m_CallbackHook.m_Original);
-// 		}
-// 	}
+	struct CallbackHook_t
+	{
+		std::vector<void*> m_Funcs;
+
+		void** m_VFunc = nullptr;
+		void* m_Original = nullptr;
+	};
+
+	// Work on Unity's main thread. The update path is hooked once; Post() queues tasks from any
+	// thread onto a lock-free list that OnUpdate drains once per frame within a time budget. Tasks
+	// that do not fit are deferred to the next frame, at least one task runs every frame.
+	namespace Callback
+	{
+		struct Task_t
+		{
+			std::function<void()> m_fTask;
+			const char* m_pName;	// Timing key, tasks without a name are counted as "unnamed"
+			Task_t* m_pNext;
+		};
+
+		struct Stats_t
+		{
+			std::atomic<uint64_t> m_uFrames = { 0 };
+			std::atomic<uint64_t> m_uExecuted = { 0 };
+			std::atomic<uint64_t> m_uDeferred = { 0 };			// Frames that ended with work left
+			std::atomic<uint64_t> m_uOverruns = { 0 };			// Frames whose tasks exceeded the budget
+			std::atomic<uint64_t> m_uLastFrameNanoseconds = { 0 };
+		};
+
+		struct TaskTiming_t
+		{
+			const char* m_pName = nullptr;
+			uint64_t m_uCalls = 0U;
+			uint64_t m_uTotalNanoseconds = 0U;
+			uint64_t m_uMaxNanoseconds = 0U;
+		};
+
+		std::atomic<Task_t*> m_pIncoming = { nullptr };
+		std::deque<Task_t*> m_Pending;	// Main thread only
+		std::atomic<uint64_t> m_uBudgetNanoseconds = { 2000000U };
+		Stats_t m_Stats;
+
+		std::mutex m_TimingMutex;
+		std::unordered_map<std::string, TaskTiming_t> m_Timings;
+
+		// Any thread.
+		void Post(std::function<void()> m_fTask, const char* m_pName = nullptr)
+		{
+			Task_t* m_pTask = new Task_t{ std::move(m_fTask), m_pName, nullptr };
+			Task_t* m_pHead = m_pIncoming.load(std::memory_order_relaxed);
+			do
+			{
+				m_pTask->m_pNext = m_pHead;
+			} while (!m_pIncoming.compare_exchange_weak(m_pHead, m_pTask, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		void SetBudget(uint64_t m_uMicroseconds)
+		{
+			m_uBudgetNanoseconds.store(m_uMicroseconds * 1000U, std::memory_order_relaxed);
+		}
+
+		// Copies the per-task timings, sorted by total time.
+		void GetTimings(std::vector<TaskTiming_t>* m_pTimings)
+		{
+			m_pTimings->clear();
+			{
+				std::lock_guard<std::mutex> m_Lock(m_TimingMutex);
+				for (const auto& m_Timing : m_Timings)
+					m_pTimings->emplace_back(m_Timing.second);
+			}
+
+			std::sort(m_pTimings->begin(), m_pTimings->end(), [](const TaskTiming_t& m_Left, const TaskTiming_t& m_Right) { return m_Left.m_uTotalNanoseconds > m_Right.m_uTotalNanoseconds; });
+		}
+
+		// Runs queued tasks until the budget is spent. Called from the update hook, or directly by
+		// whatever already runs once per frame on the main thread.
+		void Tick()
+		{
+			using Clock_t = std::chrono::steady_clock;
+			auto m_Elapsed = [](Clock_t::time_point m_Start) { return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock_t::now() - m_Start).count()); };
+
+			// Taken newest first, reversed to keep submission order.
+			Task_t* m_pTaken = m_pIncoming.exchange(nullptr, std::memory_order_acquire);
+			size_t m_sOldPending = m_Pending.size();
+			for (; m_pTaken; m_pTaken = m_pTaken->m_pNext)
+				m_Pending.emplace_back(m_pTaken);
+			std::reverse(m_Pending.begin() + m_sOldPending, m_Pending.end());
+
+			m_Stats.m_uFrames.fetch_add(1, std::memory_order_relaxed);
+			if (m_Pending.empty())
+			{
+				m_Stats.m_uLastFrameNanoseconds.store(0U, std::memory_order_relaxed);
+				return;
+			}
+
+			uint64_t m_uBudget = m_uBudgetNanoseconds.load(std::memory_order_relaxed);
+			Clock_t::time_point m_FrameStart = Clock_t::now();
+			uint64_t m_uSpent = 0U;
+			do
+			{
+				Task_t* m_pTask = m_Pending.front();
+				m_Pending.pop_front();
+
+				Clock_t::time_point m_TaskStart = Clock_t::now();
+				m_pTask->m_fTask();
+				uint64_t m_uTaskTime = m_Elapsed(m_TaskStart);
+
+				{
+					std::lock_guard<std::mutex> m_Lock(m_TimingMutex);
+					const char* m_pName = m_pTask->m_pName ? m_pTask->m_pName : "unnamed";
+					TaskTiming_t& m_Timing = m_Timings[m_pName];
+					m_Timing.m_pName = m_pName;
+					++m_Timing.m_uCalls;
+					m_Timing.m_uTotalNanoseconds += m_uTaskTime;
+					m_Timing.m_uMaxNanoseconds = (std::max)(m_Timing.m_uMaxNanoseconds, m_uTaskTime);
+				}
+
+				delete m_pTask;
+				m_Stats.m_uExecuted.fetch_add(1, std::memory_order_relaxed);
+				m_uSpent = m_Elapsed(m_FrameStart);
+			} while (!m_Pending.empty() && m_uBudget > m_uSpent);
+
+			if (m_uSpent > m_uBudget)
+				m_Stats.m_uOverruns.fetch_add(1, std::memory_order_relaxed);
+
+			if (!m_Pending.empty())
+				m_Stats.m_uDeferred.fetch_add(1, std::memory_order_relaxed);
+
+			m_Stats.m_uLastFrameNanoseconds.store(m_uSpent, std::memory_order_relaxed);
+		}
+
+		// Update and LateUpdate are one native vtable slot shared by every MonoBehaviour, so the hooks
+		// run once per behaviour per frame. Only the first call of a frame runs the callbacks and Tick(),
+		// keyed on Time.frameCount, or on the first behaviour seen when that icall can't be resolved.
+		struct FrameGate_t
+		{
+			int m_iLastFrame = -1;
+			void* m_pAnchor = nullptr;
+			std::chrono::steady_clock::time_point m_AnchorSeen;
+
+			// Main thread only.
+			bool Enter(void* m_pThis)
+			{
+				static int(UNITY_CALLING_CONVENTION m_GetFrameCount)() = reinterpret_cast<int(UNITY_CALLING_CONVENTION)()>(ResolveCall(UNITY_TIME_GETFRAMECOUNT));
+				if (m_GetFrameCount)
+				{
+					int m_iFrame = m_GetFrameCount();
+					if (m_iFrame == m_iLastFrame)
+						return false;
+
+					m_iLastFrame = m_iFrame;
+					return true;
+				}
+
+				// A frame starts each time the anchor updates; re-anchored once it stops updating, e.g. destroyed or disabled.
+				std::chrono::steady_clock::time_point m_Now = std::chrono::steady_clock::now();
+				if (m_pAnchor && m_pAnchor != m_pThis && std::chrono::seconds(1) > m_Now - m_AnchorSeen)
+					return false;
+
+				m_pAnchor = m_pThis;
+				m_AnchorSeen = m_Now;
+				return true;
+			}
+		};
+
+		// Commit() publishes the original before swapping the slot, a null one is only seen after Uninitialize.
+		void CallOriginal(CallbackHook_t& m_CallbackHook, void* m_pThis)
+		{
+			void* m_pOriginal = __atomic_load_n(&m_CallbackHook.m_Original, __ATOMIC_ACQUIRE);
+			if (m_pOriginal)
+				reinterpret_cast<void(*)(void*)>(m_pOriginal)(m_pThis);
+		}
+
+		namespace OnUpdate
+		{
+			CallbackHook_t m_CallbackHook;
+			FrameGate_t m_FrameGate;
+
+			// Runs once per frame, before the queued tasks. Add before Initialize.
+			void Add(void* m_pFunction)
+			{
+				m_CallbackHook.m_Funcs.emplace_back(m_pFunction);
+			}
+
+			void Hook(void* m_pThis)
+			{
+				if (m_FrameGate.Enter(m_pThis))
+				{
+					for (void* m_Func : m_CallbackHook.m_Funcs)
+						reinterpret_cast<void(*)()>(m_Func)();
+
+					Tick();
+				}
+
+				CallOriginal(m_CallbackHook, m_pThis);
+			}
+		}
+
+		namespace OnLateUpdate
+		{
+			CallbackHook_t m_CallbackHook;
+			FrameGate_t m_FrameGate;
+
+			void Add(void* m_pFunction)
+			{
+				m_CallbackHook.m_Funcs.emplace_back(m_pFunction);
+			}
+
+			void Hook(void* m_pThis)
+			{
+				if (m_FrameGate.Enter(m_pThis))
+				{
+					for (void* m_Func : m_CallbackHook.m_Funcs)
+						reinterpret_cast<void(*)()>(m_Func)();
+				}
+
+				CallOriginal(m_CallbackHook, m_pThis);
+			}
+		}
+
+		// The MonoBehaviour update thunks have no portable signature on ARM, so the caller passes
+		// the vtable slots, e.g. from Utils::VTable::FindFunction with a signature for the game's
+		// engine build. m_pLateUpdateSlot may be nullptr.
+		bool Initialize(void** m_pUpdateSlot, void** m_pLateUpdateSlot = nullptr)
+		{
+			if (!m_pUpdateSlot || OnUpdate::m_CallbackHook.m_VFunc)
+				return false;
+
+			OnUpdate::m_CallbackHook.m_VFunc = m_pUpdateSlot;
+			Utils::VTable::ReplaceFunction(m_pUpdateSlot, reinterpret_cast<void*>(OnUpdate::Hook), &OnUpdate::m_CallbackHook.m_Original);
+
+			if (m_pLateUpdateSlot)
+			{
+				OnLateUpdate::m_CallbackHook.m_VFunc = m_pLateUpdateSlot;
+				Utils::VTable::ReplaceFunction(m_pLateUpdateSlot, reinterpret_cast<void*>(OnLateUpdate::Hook), &OnLateUpdate::m_CallbackHook.m_Original);
+			}
+
+			return OnUpdate::m_CallbackHook.m_Original != nullptr;
+		}
+
+		// Native vtable of a live MonoBehaviour, to search for the update slots in.
+		void** GetMonoBehaviourVTable()
+		{
+			void* m_IL2CPPThread = Thread::AttachCurrent();
+			Unity::CComponent* m_MonoBehaviour = m_IL2CPPThread ? IL2CPP::Helper::GetMonoBehaviour() : nullptr;
+			if (!m_MonoBehaviour || !m_MonoBehaviour->m_CachedPtr)
+				return nullptr;
+
+			return *reinterpret_cast<void***>(m_MonoBehaviour->m_CachedPtr);
+		}
+
+		void Uninitialize()
+		{
+			if (OnUpdate::m_CallbackHook.m_VFunc)
+				Utils::VTable::ReplaceFunction(OnUpdate::m_CallbackHook.m_VFunc, OnUpdate::m_CallbackHook.m_Original);
+
+			if (OnLateUpdate::m_CallbackHook.m_VFunc)
+				Utils::VTable::ReplaceFunction(OnLateUpdate::m_CallbackHook.m_VFunc, OnLateUpdate::m_CallbackHook.m_Original);
+
+			OnUpdate::m_CallbackHook.m_VFunc = nullptr;
+			OnLateUpdate::m_CallbackHook.m_VFunc = nullptr;
+		}
+	}
 }
@@ -60,41 +60,128 @@ namespace IL2CPP
             return (Unity::il2cppClass*) il2cpp_class_from_name ((const Il2CppImage *) m_pImage, m_pNamespace, m_pName);
         }
 
-        Unity::il2cppClass* Find(const char* m_pName)
+        Unity::il2cppClass* FindUncached(const char* m_pName)
         {
             size_t m_sAssembliesCount = 0U;
             Unity::il2cppAssembly** m_pAssemblies = Domain::GetAssemblies(&m_sAssembliesCount);
             if (!m_pAssemblies || 0U >= m_sAssembliesCount) return nullptr;
 
+            // Namespace is copied to the stack, the few names longer than that go to the heap.
+            char m_NameSpaceBuffer[256] = { 0 };
+            std::string m_sNameSpaceLong;
+            const char* m_pNameSpace = m_NameSpaceBuffer;
+
             const char* m_pNameSpaceEnd = strrchr(m_pName, '.');
-            char* m_pNameSpace = nullptr;
             if (m_pNameSpaceEnd)
             {
-                uintptr_t m_uNamespaceSize = static_cast<uintptr_t>(m_pNameSpaceEnd - m_pName);
-                m_pNameSpace = new char[m_uNamespaceSize + 1];
-                memcpy(m_pNameSpace, m_pName, m_uNamespaceSize);
-                m_pNameSpace[m_uNamespaceSize] = '\0';
+                size_t m_uNamespaceSize = static_cast<size_t>(m_pNameSpaceEnd - m_pName);
+                if (m_uNamespaceSize < sizeof(m_NameSpaceBuffer))
+                    memcpy(m_NameSpaceBuffer, m_pName, m_uNamespaceSize);
+                else
+                {
+                    m_sNameSpaceLong.assign(m_pName, m_uNamespaceSize);
+                    m_pNameSpace = m_sNameSpaceLong.c_str();
+                }
 
                 m_pName = m_pNameSpaceEnd + 1;
             }
-            else
-            {
-                m_pNameSpace = new char[2];
-                memset(m_pNameSpace, 0, 2);
-            }
 
-            Unity::il2cppClass* m_pClassReturn = nullptr;
             for (size_t i = 0U; m_sAssembliesCount > i; ++i)
             {
                 Unity::il2cppAssembly* m_pAssembly = m_pAssemblies[i];
                 if (!m_pAssembly || !m_pAssembly->m_pImage) continue;
 
-                m_pClassReturn = GetFromName(m_pAssembly->m_pImage, m_pNameSpace, m_pName);
-                if (m_pClassReturn) break;
+                Unity::il2cppClass* m_pClassReturn = GetFromName(m_pAssembly->m_pImage, m_pNameSpace, m_pName);
+                if (m_pClassReturn) return m_pClassReturn;
             }
 
-            delete[] m_pNameSpace;
-            return m_pClassReturn;
+            return nullptr;
+        }
+
+        // Results of Find, keyed by the hash of the full name and verified against it. Misses are
+        // remembered too, but retried once the domain has gained assemblies since the miss was recorded.
+        namespace FindCache
+        {
+            struct Entry_t
+            {
+                std::atomic<Unity::il2cppClass*> m_pClass = { nullptr };
+                std::atomic<size_t> m_sAssemblies = { 0U };
+            };
+
+            struct Stats_t
+            {
+                std::atomic<uint64_t> m_uHits = { 0 };
+                std::atomic<uint64_t> m_uMisses = { 0 };
+                std::atomic<uint64_t> m_uResolved = { 0 };
+            };
+
+            IL2CPP::Utils::CFlatHashMap<Entry_t> m_Map(1024);
+            Stats_t m_Stats;
+
+            // Turns every entry into a miss that is retried on the next lookup.
+            void Clear()
+            {
+                m_Map.ForEach([](Entry_t& m_Entry)
+                {
+                    m_Entry.m_pClass.store(nullptr, std::memory_order_relaxed);
+                    m_Entry.m_sAssemblies.store(SIZE_MAX, std::memory_order_relaxed);
+                });
+            }
+        }
+
+        // m_uHash must be Utils::Hash::Get(m_pName), use IL2CPP_FIND_CLASS to have it computed at compile time.
+        Unity::il2cppClass* Find(const char* m_pName, uint32_t m_uHash)
+        {
+            size_t m_sAssembliesCount = 0U;
+            FindCache::Entry_t* m_pEntry = FindCache::m_Map.Find(m_uHash, m_uHash, m_pName);
+            if (m_pEntry)
+            {
+                Unity::il2cppClass* m_pClass = m_pEntry->m_pClass.load(std::memory_order_acquire);
+                if (m_pClass)
+                {
+                    FindCache::m_Stats.m_uHits.fetch_add(1, std::memory_order_relaxed);
+                    return m_pClass;
+                }
+
+                // The class is stored before the count, so one stored with this count is visible now.
+                size_t m_sCachedAssemblies = m_pEntry->m_sAssemblies.load(std::memory_order_acquire);
+                m_pClass = m_pEntry->m_pClass.load(std::memory_order_acquire);
+                if (m_pClass)
+                {
+                    FindCache::m_Stats.m_uHits.fetch_add(1, std::memory_order_relaxed);
+                    return m_pClass;
+                }
+
+                Domain::GetAssemblies(&m_sAssembliesCount);
+                if (m_sAssembliesCount == m_sCachedAssemblies)
+                {
+                    FindCache::m_Stats.m_uMisses.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+            }
+
+            Domain::GetAssemblies(&m_sAssembliesCount);
+            Unity::il2cppClass* m_pClass = FindUncached(m_pName);
+            FindCache::m_Stats.m_uResolved.fetch_add(1, std::memory_order_relaxed);
+
+            // A new entry is filled before Insert publishes it; an existing one gets the class
+            // first and the count last, so a reader that sees the new count also sees the class.
+            auto m_fFill = [m_pClass, m_sAssembliesCount](FindCache::Entry_t& m_Entry)
+            {
+                m_Entry.m_pClass.store(m_pClass, std::memory_order_release);
+                m_Entry.m_sAssemblies.store(m_sAssembliesCount, std::memory_order_release);
+            };
+
+            if (!m_pEntry)
+                m_pEntry = FindCache::m_Map.Insert(m_uHash, m_uHash, m_pName, m_fFill);
+
+            m_fFill(*m_pEntry);
+            return m_pClass;
+        }
+
+        Unity::il2cppClass* Find(const char* m_pName)
+        {
+            return Find(m_pName, IL2CPP::Utils::Hash::Get(m_pName));
         }
 
         Unity::il2cppObject* GetSystemType(const char* m_pClassName)
@@ -106,50 +193,156 @@ namespace IL2CPP
             return GetSystemType(m_pClass);
         }
 
-        void FetchClasses(std::vector<Unity::il2cppClass*>* m_pVector, const char* m_pModuleName, const char* m_pNamespace)
+        // Class lists of each image, read once and grouped by namespace. Images never change after
+        // they are loaded, so entries live forever; only a module that was not found is looked up
+        // again, once the domain has gained assemblies.
+        namespace ImageCache
         {
-            m_pVector->clear();
+            struct View_t
+            {
+                Unity::il2cppClass* const* m_pBegin = nullptr;
+                Unity::il2cppClass* const* m_pEnd = nullptr;
 
-            size_t m_sAssembliesCount = 0U;
-            Unity::il2cppAssembly** m_pAssemblies = Domain::GetAssemblies(&m_sAssembliesCount);
-            if (!m_pAssemblies || 0U >= m_sAssembliesCount) return;
+                Unity::il2cppClass* const* begin() const { return m_pBegin; }
+                Unity::il2cppClass* const* end() const { return m_pEnd; }
+                size_t size() const { return static_cast<size_t>(m_pEnd - m_pBegin); }
+                bool empty() const { return m_pBegin == m_pEnd; }
+            };
 
-            Unity::il2cppImage* m_pImage = nullptr;
-            for (size_t i = 0U; m_sAssembliesCount > i; ++i)
+            struct Namespace_t
             {
-                Unity::il2cppAssembly* m_pAssembly = m_pAssemblies[i];
-                if (!m_pAssembly || !m_pAssembly->m_pImage || strcmp(m_pAssembly->m_pImage->m_pNameNoExt, m_pModuleName) != 0)
-                    continue;
+                const char* m_pName;
+                size_t m_sBegin;
+                size_t m_sEnd;
+            };
 
-                m_pImage = m_pAssembly->m_pImage;
-                break;
-            }
+            struct Image_t
+            {
+                Unity::il2cppImage* m_pImage = nullptr;
+                std::vector<Unity::il2cppClass*> m_vClasses;       // Image order
+                std::vector<Unity::il2cppClass*> m_vByNamespace;   // Image order within each namespace
+                std::vector<Namespace_t> m_vNamespaces;            // Sorted by name
+            };
+
+            // m_sAssemblies is only set while the module is absent: the domain's assembly count
+            // when it was not found. SIZE_MAX until then.
+            struct Entry_t
+            {
+                std::atomic<const Image_t*> m_pImage = { nullptr };
+                std::atomic<size_t> m_sAssemblies = { SIZE_MAX };
+            };
+
+            IL2CPP::Utils::CFlatHashMap<Entry_t> m_Map(64);
 
-            if (m_pImage)
+            const Image_t* Build(Unity::il2cppImage* m_pImage)
             {
-                //size_t m_sClassesCount = reinterpret_cast<size_t(IL2CPP_CALLING_CONVENTION)(void*)>(Functions.m_ImageGetClassCount)(m_pImage);
-                size_t m_sClassesCount =  il2cpp_image_get_class_count ((const Il2CppImage *) m_pImage);
+                Image_t* m_pEntry = new Image_t();
+                m_pEntry->m_pImage = m_pImage;
 
+                size_t m_sClassesCount = il2cpp_image_get_class_count((const Il2CppImage *) m_pImage);
+                m_pEntry->m_vClasses.reserve(m_sClassesCount);
                 for (size_t i = 0U; m_sClassesCount > i; ++i)
+                    m_pEntry->m_vClasses.emplace_back((Unity::il2cppClass*) il2cpp_image_get_class((const Il2CppImage *) m_pImage, i));
+
+                m_pEntry->m_vByNamespace = m_pEntry->m_vClasses;
+                std::stable_sort(m_pEntry->m_vByNamespace.begin(), m_pEntry->m_vByNamespace.end(), [](Unity::il2cppClass* m_pLeft, Unity::il2cppClass* m_pRight) { return strcmp(m_pLeft->m_pNamespace, m_pRight->m_pNamespace) < 0; });
+
+                for (size_t i = 0U; m_pEntry->m_vByNamespace.size() > i; ++i)
                 {
-                    //Unity::il2cppClass* m_pClass = reinterpret_cast<Unity::il2cppClass * (IL2CPP_CALLING_CONVENTION)(void*, size_t)>(Functions.m_ImageGetClass)(m_pImage, i);
-                    Unity::il2cppClass* m_pClass = (Unity::il2cppClass*) il2cpp_image_get_class ((const Il2CppImage *) m_pImage, i);
-                    if (m_pNamespace)
-                    {
-                        if (m_pNamespace[0] == '\0')
-                        {
-                            if (m_pClass->m_pNamespace[0] != '\0')
-                                continue;
-                        }
-                        else if (strcmp(m_pClass->m_pNamespace, m_pNamespace) != 0)
-                            continue;
-                    }
+                    const char* m_pNamespace = m_pEntry->m_vByNamespace[i]->m_pNamespace;
+                    if (m_pEntry->m_vNamespaces.empty() || strcmp(m_pEntry->m_vNamespaces.back().m_pName, m_pNamespace) != 0)
+                        m_pEntry->m_vNamespaces.push_back({ m_pNamespace, i, i });
 
-                    m_pVector->emplace_back(m_pClass);
+                    m_pEntry->m_vNamespaces.back().m_sEnd = i + 1;
                 }
+
+                return m_pEntry;
+            }
+
+            const Image_t* Get(const char* m_pModuleName)
+            {
+                uint32_t m_uHash = IL2CPP::Utils::Hash::Get(m_pModuleName);
+                size_t m_sAssembliesCount = 0U;
+                Unity::il2cppAssembly** m_pAssemblies = Domain::GetAssemblies(&m_sAssembliesCount);
+
+                Entry_t* m_pEntry = m_Map.Find(m_uHash, m_uHash, m_pModuleName);
+                if (m_pEntry)
+                {
+                    const Image_t* m_pImage = m_pEntry->m_pImage.load(std::memory_order_acquire);
+                    if (m_pImage)
+                        return m_pImage;
+
+                    // Re-read the image after the count, a module found since then is published already.
+                    size_t m_sCachedAssemblies = m_pEntry->m_sAssemblies.load(std::memory_order_acquire);
+                    m_pImage = m_pEntry->m_pImage.load(std::memory_order_acquire);
+                    if (m_pImage || m_sCachedAssemblies == m_sAssembliesCount)
+                        return m_pImage;
+                }
+
+                Unity::il2cppImage* m_pImage = nullptr;
+                for (size_t i = 0U; m_pAssemblies && m_sAssembliesCount > i; ++i)
+                {
+                    Unity::il2cppAssembly* m_pAssembly = m_pAssemblies[i];
+                    if (!m_pAssembly || !m_pAssembly->m_pImage || strcmp(m_pAssembly->m_pImage->m_pNameNoExt, m_pModuleName) != 0)
+                        continue;
+
+                    m_pImage = m_pAssembly->m_pImage;
+                    break;
+                }
+
+                if (!m_pImage)
+                {
+                    // Only a miss records the count; an entry with a published image never needs it.
+                    auto m_fMiss = [m_sAssembliesCount](Entry_t& m_Entry) { m_Entry.m_sAssemblies.store(m_sAssembliesCount, std::memory_order_release); };
+                    if (!m_pEntry)
+                        m_pEntry = m_Map.Insert(m_uHash, m_uHash, m_pModuleName, m_fMiss);
+
+                    if (!m_pEntry->m_pImage.load(std::memory_order_acquire))
+                        m_fMiss(*m_pEntry);
+                    return m_pEntry->m_pImage.load(std::memory_order_acquire);
+                }
+
+                // Built before the entry is touched, so readers never see it half done. A racing
+                // thread may have published one already, keep that.
+                const Image_t* m_pBuilt = Build(m_pImage);
+                if (!m_pEntry)
+                    m_pEntry = m_Map.Insert(m_uHash, m_uHash, m_pModuleName, [m_pBuilt](Entry_t& m_Entry) { m_Entry.m_pImage.store(m_pBuilt, std::memory_order_release); });
+
+                const Image_t* m_pExpected = nullptr;
+                if (!m_pEntry->m_pImage.compare_exchange_strong(m_pExpected, m_pBuilt, std::memory_order_acq_rel) && m_pExpected != m_pBuilt)
+                {
+                    delete m_pBuilt;
+                    return m_pExpected;
+                }
+
+                return m_pBuilt;
+            }
+
+            // nullptr namespace selects every class of the image, "" the global namespace.
+            View_t GetClasses(const char* m_pModuleName, const char* m_pNamespace)
+            {
+                const Image_t* m_pImage = Get(m_pModuleName);
+                if (!m_pImage)
+                    return {};
+
+                if (!m_pNamespace)
+                    return { m_pImage->m_vClasses.data(), m_pImage->m_vClasses.data() + m_pImage->m_vClasses.size() };
+
+                auto m_It = std::lower_bound(m_pImage->m_vNamespaces.begin(), m_pImage->m_vNamespaces.end(), m_pNamespace, [](const Namespace_t& m_Namespace, const char* m_pName) { return strcmp(m_Namespace.m_pName, m_pName) < 0; });
+                if (m_It == m_pImage->m_vNamespaces.end() || strcmp(m_It->m_pName, m_pNamespace) != 0)
+                    return {};
+
+                Unity::il2cppClass* const* m_pClasses = m_pImage->m_vByNamespace.data();
+                return { m_pClasses + m_It->m_sBegin, m_pClasses + m_It->m_sEnd };
             }
         }
 
+        void FetchClasses(std::vector<Unity::il2cppClass*>* m_pVector, const char* m_pModuleName, const char* m_pNamespace)
+        {
+            ImageCache::View_t m_View = ImageCache::GetClasses(m_pModuleName, m_pNamespace);
+            m_pVector->assign(m_View.begin(), m_View.end());
+        }
+
         namespace Utils
         {
             int GetFieldOffset(Unity::il2cppClass* m_pClass, const char* m_pName)
@@ -304,51 +497,189 @@ namespace IL2CPP
                 return nullptr;
             }
 
-            Unity::il2cppClass* FilterClass(std::vector<Unity::il2cppClass*>* m_pClasses, std::initializer_list<const char*> m_vNames, int m_iFoundCount = -1)
+            // Sorted member-name hashes per class, built once per class on first use. FilterClass
+            // checks a 64 bit Bloom mask and binary searches these instead of asking il2cpp per name.
+            namespace MemberIndex
             {
-                int m_iNamesCount = static_cast<int>(m_vNames.size());
-                const char** m_pNames = const_cast<const char**>(m_vNames.begin());
+                struct Member_t
+                {
+                    uint32_t m_uHash;
+                    const char* m_pName;
 
-                if (0 >= m_iFoundCount || m_iFoundCount > m_iNamesCount)
-                    m_iFoundCount = m_iNamesCount;
+                    bool operator<(const Member_t& m_Other) const { return m_uHash < m_Other.m_uHash; }
+                };
 
-                Unity::il2cppClass* m_pReturn = nullptr;
-                for (size_t c = 0; m_pClasses->size() > c; ++c)
+                struct Fingerprint_t
                 {
-                    int m_iFoundCountNow = 0;
+                    uint64_t m_uBloom = 0U;
+                    std::vector<Member_t> m_Fields;     // Fields with an offset, as GetFieldOffset sees them
+                    std::vector<Member_t> m_Methods;    // Methods with code, including inherited ones
+                };
 
-                    Unity::il2cppClass* m_pClass = m_pClasses->operator[](c);
-                    if (!m_pClass)
-                        continue;
+                struct Query_t
+                {
+                    uint32_t m_uHash;
+                    const char* m_pName;
+                    bool m_bField;
+                    bool m_bMethod;
+                };
 
-                    for (int i = 0; m_iNamesCount > i; ++i)
+                IL2CPP::Utils::CFlatHashMap<Fingerprint_t> m_Map(4096);
+
+                uint64_t BloomMask(uint32_t m_uHash)
+                {
+                    return (1ULL << (m_uHash & 63U)) | (1ULL << ((m_uHash >> 6) & 63U));
+                }
+
+                Fingerprint_t Build(Unity::il2cppClass* m_pClass)
+                {
+                    Fingerprint_t m_Fingerprint;
+
+                    void* m_pIterator = nullptr;
+                    while (Unity::il2cppFieldInfo* m_pField = GetFields(m_pClass, &m_pIterator))
+                    {
+                        if (m_pField->m_iOffset >= 0)
+                            m_Fingerprint.m_Fields.push_back({ IL2CPP::Utils::Hash::Get(m_pField->m_pName), m_pField->m_pName });
+                    }
+
+                    for (Unity::il2cppClass* m_pCurrent = m_pClass; m_pCurrent; m_pCurrent = (Unity::il2cppClass*) il2cpp_class_get_parent((Il2CppClass *) m_pCurrent))
                     {
-                        const char* m_pNameToFind = m_pNames[i];
-
-                        bool m_bFoundInClass = false;
-                        if (m_pNameToFind[0] == '~') // Field
-                            m_bFoundInClass = GetFieldOffset(m_pClass, &m_pNameToFind[1]) >= 0;
-                        else if (m_pNameToFind[0] == '-') // Method
-                            m_bFoundInClass = GetMethodPointer(m_pClass, &m_pNameToFind[1]) != nullptr;
-                        else // Both
+                        m_pIterator = nullptr;
+                        while (Unity::il2cppMethodInfo* m_pMethod = GetMethods(m_pCurrent, &m_pIterator))
                         {
-                            m_bFoundInClass = GetFieldOffset(m_pClass, m_pNameToFind) >= 0;
-                            if (!m_bFoundInClass)
-                                m_bFoundInClass = GetMethodPointer(m_pClass, m_pNameToFind) != nullptr;
+                            if (m_pMethod->m_pMethodPointer)
+                                m_Fingerprint.m_Methods.push_back({ IL2CPP::Utils::Hash::Get(m_pMethod->m_pName), m_pMethod->m_pName });
                         }
+                    }
 
-                        if (m_bFoundInClass)
-                            ++m_iFoundCountNow;
+                    for (std::vector<Member_t>* m_pMembers : { &m_Fingerprint.m_Fields, &m_Fingerprint.m_Methods })
+                    {
+                        std::sort(m_pMembers->begin(), m_pMembers->end());
+                        for (const Member_t& m_Member : *m_pMembers)
+                            m_Fingerprint.m_uBloom |= BloomMask(m_Member.m_uHash);
                     }
 
-                    if (m_iFoundCount == m_iFoundCountNow)
+                    return m_Fingerprint;
+                }
+
+                const Fingerprint_t& Get(Unity::il2cppClass* m_pClass)
+                {
+                    uint64_t m_uKey = reinterpret_cast<uintptr_t>(m_pClass);
+                    if (const Fingerprint_t* m_pFingerprint = m_Map.Find(m_uKey, 0U))
+                        return *m_pFingerprint;
+
+                    Fingerprint_t m_Fingerprint = Build(m_pClass);
+                    return *m_Map.Insert(m_uKey, 0U, nullptr, [&m_Fingerprint](Fingerprint_t& m_Value) { m_Value = std::move(m_Fingerprint); });
+                }
+
+                // Builds the fingerprints of every class up front, e.g. right after FetchClasses.
+                void Prepare(std::vector<Unity::il2cppClass*>* m_pClasses)
+                {
+                    for (Unity::il2cppClass* m_pClass : *m_pClasses)
                     {
-                        m_pReturn = m_pClass;
-                        break;
+                        if (m_pClass)
+                            Get(m_pClass);
                     }
                 }
 
-                return m_pReturn;
+                // "~name" is a field, "-name" a method, anything else either.
+                Query_t MakeQuery(const char* m_pName)
+                {
+                    Query_t m_Query = { 0U, m_pName, true, true };
+                    if (m_pName[0] == '~' || m_pName[0] == '-')
+                    {
+                        m_Query.m_bField = m_pName[0] == '~';
+                        m_Query.m_bMethod = m_pName[0] == '-';
+                        ++m_Query.m_pName;
+                    }
+
+                    m_Query.m_uHash = IL2CPP::Utils::Hash::Get(m_Query.m_pName);
+                    return m_Query;
+                }
+
+                bool Contains(const std::vector<Member_t>& m_Members, const Query_t& m_Query)
+                {
+                    auto m_Range = std::equal_range(m_Members.begin(), m_Members.end(), Member_t{ m_Query.m_uHash, nullptr });
+                    for (auto m_It = m_Range.first; m_It != m_Range.second; ++m_It)
+                    {
+                        if (strcmp(m_It->m_pName, m_Query.m_pName) == 0)
+                            return true;
+                    }
+
+                    return false;
+                }
+
+                bool Matches(const Fingerprint_t& m_Fingerprint, const Query_t& m_Query)
+                {
+                    uint64_t m_uMask = BloomMask(m_Query.m_uHash);
+                    if ((m_Fingerprint.m_uBloom & m_uMask) != m_uMask)
+                        return false;
+
+                    return (m_Query.m_bField && Contains(m_Fingerprint.m_Fields, m_Query)) || (m_Query.m_bMethod && Contains(m_Fingerprint.m_Methods, m_Query));
+                }
+
+                int CountMatches(const Fingerprint_t& m_Fingerprint, const std::vector<Query_t>& m_vQueries)
+                {
+                    int m_iFound = 0;
+                    for (const Query_t& m_Query : m_vQueries)
+                    {
+                        if (Matches(m_Fingerprint, m_Query))
+                            ++m_iFound;
+                    }
+
+                    return m_iFound;
+                }
+            }
+
+            Unity::il2cppClass* FilterClass(std::vector<Unity::il2cppClass*>* m_pClasses, std::initializer_list<const char*> m_vNames, int m_iFoundCount = -1)
+            {
+                int m_iNamesCount = static_cast<int>(m_vNames.size());
+                if (0 >= m_iFoundCount || m_iFoundCount > m_iNamesCount)
+                    m_iFoundCount = m_iNamesCount;
+
+                std::vector<MemberIndex::Query_t> m_vQueries;
+                for (const char* m_pName : m_vNames)
+                    m_vQueries.emplace_back(MemberIndex::MakeQuery(m_pName));
+
+                for (Unity::il2cppClass* m_pClass : *m_pClasses)
+                {
+                    if (m_pClass && MemberIndex::CountMatches(MemberIndex::Get(m_pClass), m_vQueries) == m_iFoundCount)
+                        return m_pClass;
+                }
+
+                return nullptr;
+            }
+
+            // Several FilterClass queries in one pass over m_pClasses, every name of a query must match.
+            // m_pResults receives the first matching class per query, or nullptr.
+            void FilterClasses(std::vector<Unity::il2cppClass*>* m_pClasses, std::initializer_list<std::initializer_list<const char*>> m_vFilters, std::vector<Unity::il2cppClass*>* m_pResults)
+            {
+                std::vector<std::vector<MemberIndex::Query_t>> m_vQueries;
+                for (const auto& m_vNames : m_vFilters)
+                {
+                    m_vQueries.emplace_back();
+                    for (const char* m_pName : m_vNames)
+                        m_vQueries.back().emplace_back(MemberIndex::MakeQuery(m_pName));
+                }
+
+                m_pResults->assign(m_vQueries.size(), nullptr);
+                size_t m_sPending = m_vQueries.size();
+                for (size_t c = 0U; m_pClasses->size() > c && m_sPending; ++c)
+                {
+                    Unity::il2cppClass* m_pClass = m_pClasses->operator[](c);
+                    if (!m_pClass)
+                        continue;
+
+                    const MemberIndex::Fingerprint_t& m_Fingerprint = MemberIndex::Get(m_pClass);
+                    for (size_t q = 0U; m_vQueries.size() > q; ++q)
+                    {
+                        if (m_pResults->operator[](q) || MemberIndex::CountMatches(m_Fingerprint, m_vQueries[q]) != static_cast<int>(m_vQueries[q].size()))
+                            continue;
+
+                        m_pResults->operator[](q) = m_pClass;
+                        --m_sPending;
+                    }
+                }
             }
 
             void* FilterClassToMethodPointer(std::vector<Unity::il2cppClass*>* m_pClasses, const char* m_pMethodName, int m_iArgs = -1)
@@ -378,6 +709,69 @@ namespace IL2CPP
         Method,			// Function of class
     };
 
+    namespace Class
+    {
+        // Field offsets and property accessors looked up by name on a class, keyed by
+        // (class, name hash) and verified against the name. Entries are immutable once published.
+        namespace MemberCache
+        {
+            struct Member_t
+            {
+                m_eClassPropType m_eType = m_eClassPropType::Unknown;
+                Unity::il2cppFieldInfo* m_pField = nullptr;
+                int m_iOffset = -1;
+                void* m_pGetter = nullptr;
+                void* m_pSetter = nullptr;
+            };
+
+            IL2CPP::Utils::CFlatHashMap<Member_t> m_Map(4096);
+
+            Member_t Resolve(Unity::il2cppClass* m_pClass, const char* m_pName)
+            {
+                Member_t m_Member;
+
+                Unity::il2cppFieldInfo* m_pField = (Unity::il2cppFieldInfo*) il2cpp_class_get_field_from_name((Il2CppClass *) m_pClass, m_pName);
+                if (m_pField)
+                {
+                    m_Member.m_eType = m_eClassPropType::Field;
+                    m_Member.m_pField = m_pField;
+                    m_Member.m_iOffset = m_pField->m_iOffset;
+                    return m_Member;
+                }
+
+                Unity::il2cppPropertyInfo* m_pProperty = (Unity::il2cppPropertyInfo*) il2cpp_class_get_property_from_name((Il2CppClass *) m_pClass, m_pName);
+                if (m_pProperty)
+                {
+                    m_Member.m_eType = m_eClassPropType::Property;
+                    if (m_pProperty->m_pGet) m_Member.m_pGetter = m_pProperty->m_pGet->m_pMethodPointer;
+                    if (m_pProperty->m_pSet) m_Member.m_pSetter = m_pProperty->m_pSet->m_pMethodPointer;
+                    return m_Member;
+                }
+
+                if (il2cpp_class_get_method_from_name((Il2CppClass *) m_pClass, m_pName, -1))
+                    m_Member.m_eType = m_eClassPropType::Method;
+
+                return m_Member;
+            }
+
+            const Member_t& Get(Unity::il2cppClass* m_pClass, const char* m_pName, uint32_t m_uHash)
+            {
+                uint64_t m_uKey = reinterpret_cast<uintptr_t>(m_pClass);
+                if (const Member_t* m_pMember = m_Map.Find(m_uKey, m_uHash, m_pName))
+                    return *m_pMember;
+
+                // Racing resolvers may both publish, the entries are identical.
+                Member_t m_Member = Resolve(m_pClass, m_pName);
+                return *m_Map.Insert(m_uKey, m_uHash, m_pName, [&m_Member](Member_t& m_Value) { m_Value = m_Member; });
+            }
+
+            const Member_t& Get(Unity::il2cppClass* m_pClass, const char* m_pName)
+            {
+                return Get(m_pClass, m_pName, IL2CPP::Utils::Hash::Get(m_pName));
+            }
+        }
+    }
+
     // Main Class
     class CClass
     {
@@ -413,22 +807,7 @@ namespace IL2CPP
 
         m_eClassPropType GetPropType(const char* m_pPropType)
         {
-            //Unity::il2cppFieldInfo* pField = reinterpret_cast<Unity::il2cppFieldInfo*(IL2CPP_CALLING_CONVENTION)(void*, const char*)>(Functions.m_ClassGetFieldFromName)(m_Object.m_pClass, m_pPropType);
-            Unity::il2cppFieldInfo* pField = (Unity::il2cppFieldInfo*) il2cpp_class_get_field_from_name ((Il2CppClass *)( m_Object.m_pClass), m_pPropType);
-            if (pField)
-                return m_eClassPropType::Field;
-
-            //Unity::il2cppPropertyInfo* pProperty = reinterpret_cast<Unity::il2cppPropertyInfo*(IL2CPP_CALLING_CONVENTION)(void*, const char*)>(Functions.m_ClassGetPropertyFromName)(m_Object.m_pClass, m_pPropType);
-            Unity::il2cppPropertyInfo* pProperty = (Unity::il2cppPropertyInfo*) il2cpp_class_get_property_from_name ((Il2CppClass *) (m_Object.m_pClass), m_pPropType);
-            if (pProperty)
-                return m_eClassPropType::Property;
-
-            //Unity::il2cppMethodInfo* pMethod = reinterpret_cast<Unity::il2cppMethodInfo*(IL2CPP_CALLING_CONVENTION)(void*, const char*, int)>(Functions.m_ClassGetMethodFromName)(m_Object.m_pClass, m_pPropType, -1);
-            Unity::il2cppMethodInfo* pMethod = (Unity::il2cppMethodInfo*) il2cpp_class_get_method_from_name ((Il2CppClass * )(m_Object.m_pClass), m_pPropType, -1);
-            if (pMethod)
-                return m_eClassPropType::Method;
-
-            return m_eClassPropType::Unknown;
+            return Class::MemberCache::Get(m_Object.m_pClass, m_pPropType).m_eType;
         }
 
         // Call Method
@@ -462,10 +841,9 @@ namespace IL2CPP
         template<typename T>
         T GetPropertyValue(const char* m_pPropertyName)
         {
-            //Unity::il2cppPropertyInfo* pProperty = reinterpret_cast<Unity::il2cppPropertyInfo * (IL2CPP_CALLING_CONVENTION)(void*, const char*)>(Functions.m_ClassGetPropertyFromName)(m_Object.m_pClass, m_pPropertyName);
-            Unity::il2cppPropertyInfo* pProperty = (Unity::il2cppPropertyInfo*) il2cpp_class_get_property_from_name ((Il2CppClass *) (m_Object.m_pClass), m_pPropertyName);
-            if (pProperty && pProperty->m_pGet)
-                return reinterpret_cast<T(UNITY_CALLING_CONVENTION)(void*)>(pProperty->m_pGet->m_pMethodPointer)(this);
+            const Class::MemberCache::Member_t& m_Member = Class::MemberCache::Get(m_Object.m_pClass, m_pPropertyName);
+            if (m_Member.m_pGetter)
+                return reinterpret_cast<T(UNITY_CALLING_CONVENTION)(void*)>(m_Member.m_pGetter)(this);
 
             T tDefault = {};
             return tDefault;
@@ -474,10 +852,9 @@ namespace IL2CPP
         template<typename T>
         void SetPropertyValue(const char* m_pPropertyName, T m_tValue)
         {
-            //Unity::il2cppPropertyInfo* pProperty = reinterpret_cast<Unity::il2cppPropertyInfo * (IL2CPP_CALLING_CONVENTION)(void*, const char*)>(Functions.m_ClassGetPropertyFromName)(m_Object.m_pClass, m_pPropertyName);
-            Unity::il2cppPropertyInfo* pProperty = (Unity::il2cppPropertyInfo*) il2cpp_class_get_property_from_name ((Il2CppClass *) (m_Object.m_pClass), m_pPropertyName);
-            if (pProperty && pProperty->m_pSet)
-                return reinterpret_cast<void(UNITY_CALLING_CONVENTION)(void*, T)>(pProperty->m_pSet->m_pMethodPointer)(this, m_tValue);
+            const Class::MemberCache::Member_t& m_Member = Class::MemberCache::Get(m_Object.m_pClass, m_pPropertyName);
+            if (m_Member.m_pSetter)
+                return reinterpret_cast<void(UNITY_CALLING_CONVENTION)(void*, T)>(m_Member.m_pSetter)(this, m_tValue);
         }
 
         template<typename T>
@@ -516,14 +893,13 @@ namespace IL2CPP
         template<typename T>
         T GetMemberValue(const char* m_pMemberName)
         {
-            //Unity::il2cppFieldInfo* pField = reinterpret_cast<Unity::il2cppFieldInfo * (IL2CPP_CALLING_CONVENTION)(void*, const char*)>(Functions.m_ClassGetFieldFromName)(m_Object.m_pClass, m_pMemberName);
-            Unity::il2cppFieldInfo* pField = (Unity::il2cppFieldInfo*) il2cpp_class_get_field_from_name( (Il2CppClass *) (m_Object.m_pClass), m_pMemberName);
-            if (pField)
+            const Class::MemberCache::Member_t& m_Member = Class::MemberCache::Get(m_Object.m_pClass, m_pMemberName);
+            if (m_Member.m_eType == m_eClassPropType::Field)
             {
-                if (pField->m_iOffset >= 0) return *reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(this) + pField->m_iOffset);
+                if (m_Member.m_iOffset >= 0) return *reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(this) + m_Member.m_iOffset);
             }
-            else
-                return GetPropertyValue<T>(m_pMemberName);
+            else if (m_Member.m_pGetter)
+                return reinterpret_cast<T(UNITY_CALLING_CONVENTION)(void*)>(m_Member.m_pGetter)(this);
 
             T tDefault = {};
             return tDefault;
@@ -532,15 +908,15 @@ namespace IL2CPP
         template<typename T>
         void SetMemberValue(const char* m_pMemberName, T m_tValue)
         {
-            //Unity::il2cppFieldInfo* pField = reinterpret_cast<Unity::il2cppFieldInfo * (IL2CPP_CALLING_CONVENTION)(void*, const char*)>(Functions.m_ClassGetFieldFromName)(m_Object.m_pClass, m_pMemberName);
-            Unity::il2cppFieldInfo* pField = (Unity::il2cppFieldInfo*) il2cpp_class_get_field_from_name( (Il2CppClass *) (m_Object.m_pClass), m_pMemberName);
-            if (pField)
+            const Class::MemberCache::Member_t& m_Member = Class::MemberCache::Get(m_Object.m_pClass, m_pMemberName);
+            if (m_Member.m_eType == m_eClassPropType::Field)
             {
-                if (pField->m_iOffset >= 0) *reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(this) + pField->m_iOffset) = m_tValue;
+                if (m_Member.m_iOffset >= 0) *reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(this) + m_Member.m_iOffset) = m_tValue;
                 return;
             }
 
-            SetPropertyValue<T>(m_pMemberName, m_tValue);
+            if (m_Member.m_pSetter)
+                reinterpret_cast<void(UNITY_CALLING_CONVENTION)(void*, T)>(m_Member.m_pSetter)(this, m_tValue);
         }
 
         template<typename T>
@@ -587,9 +963,8 @@ namespace IL2CPP
         template<typename T>
         T GetObscuredValue(const char* m_pMemberName)
         {
-            // Unity::il2cppFieldInfo* m_pField = reinterpret_cast<Unity::il2cppFieldInfo * (IL2CPP_CALLING_CONVENTION)(void*, const char*)>(Functions.m_ClassGetFieldFromName)(m_Object.m_pClass, m_pMemberName);
-            Unity::il2cppFieldInfo* m_pField = (Unity::il2cppFieldInfo*) il2cpp_class_get_field_from_name( (Il2CppClass *) (m_Object.m_pClass), m_pMemberName);
-            return GetObscuredViaOffset<T>(m_pField ? m_pField->m_iOffset : -1);
+            const Class::MemberCache::Member_t& m_Member = Class::MemberCache::Get(m_Object.m_pClass, m_pMemberName);
+            return GetObscuredViaOffset<T>(m_Member.m_eType == m_eClassPropType::Field ? m_Member.m_iOffset : -1);
         }
 
         template<typename T>
@@ -630,13 +1005,11 @@ namespace IL2CPP
         template<typename T>
         void SetObscuredValue(const char* m_pMemberName, T m_tValue)
         {
-            // Unity::il2cppFieldInfo* m_pField = reinterpret_cast<Unity::il2cppFieldInfo * (IL2CPP_CALLING_CONVENTION)(void*, const char*)>(Functions.m_ClassGetFieldFromName)(m_Object.m_pClass, m_pMemberName);
-            Unity::il2cppFieldInfo* m_pField = (Unity::il2cppFieldInfo *) il2cpp_class_get_field_from_name ((Il2CppClass *) (m_Object.m_pClass), m_pMemberName);
-
-            if (!m_pField)
+            const Class::MemberCache::Member_t& m_Member = Class::MemberCache::Get(m_Object.m_pClass, m_pMemberName);
+            if (m_Member.m_eType != m_eClassPropType::Field)
                 return;
 
-            SetObscuredViaOffset<T>(m_pField->m_iOffset, m_tValue);
+            SetObscuredViaOffset<T>(m_Member.m_iOffset, m_tValue);
         }
     };
 }
@@ -0,0 +1,262 @@
+#pragma once
+
+// Manifest tables are constexpr by default. If IL2CPP_RStr decrypts at runtime, define this as const.
+#ifndef IL2CPP_MANIFEST_STORAGE
+	#define IL2CPP_MANIFEST_STORAGE constexpr
+#endif
+
+namespace IL2CPP
+{
+	// Everything a module needs resolved, declared up front as a table:
+	//
+	//	IL2CPP_MANIFEST_STORAGE IL2CPP::Manifest::Entry_t m_Manifest[] =
+	//	{
+	//		IL2CPP::Manifest::SystemType("UnityEngine.Camera"),
+	//		IL2CPP::Manifest::ICall("UnityEngine.Camera::get_main", &m_CameraFunctions.m_GetMain),
+	//		IL2CPP::Manifest::Method("Game.Player", "Update", 0, &m_pUpdate),
+	//		IL2CPP::Manifest::Field("Game.Player", "m_Health", &m_iHealthOffset),
+	//	};
+	//
+	// Modules hand their table to Register() and IL2CPP::Initialize resolves all of them in one pass,
+	// writing straight into the targets, so call sites read a plain member or global afterwards.
+	// Entry ids are the IL2CPP_HASH of the qualified name; entries with the same id are resolved once.
+	namespace Manifest
+	{
+		enum class m_eEntryType : uint8_t
+		{
+			Class,			// Unity::il2cppClass** target
+			SystemType,		// SystemTypeCache, target unused
+			Method,			// void** target, method pointer
+			Field,			// int* target, field offset
+			ICall,			// void** target
+		};
+
+		struct Entry_t
+		{
+			m_eEntryType m_eType;
+			uint32_t m_uId;
+			const char* m_pClass;
+			const char* m_pName;	// Method/field name, or the icall signature
+			int m_iArgs;			// Method only, -1 matches any count
+			void* m_pTarget;
+		};
+
+		// Same hash as Utils::Hash over "Class::Name", without building the string.
+		constexpr uint32_t GetId(const char* m_pClass, const char* m_pName)
+		{
+			uint32_t m_Hash = 0;
+			const char* m_pParts[] = { m_pClass, m_pName ? "::" : "", m_pName ? m_pName : "" };
+			for (const char* m_pPart : m_pParts)
+			{
+				for (; *m_pPart; ++m_pPart)
+				{
+					m_Hash += *m_pPart;
+					m_Hash += m_Hash << 10;
+					m_Hash ^= m_Hash >> 6;
+				}
+			}
+
+			m_Hash += m_Hash << 3;
+			m_Hash ^= m_Hash >> 11;
+			m_Hash += m_Hash << 15;
+
+			return m_Hash;
+		}
+
+		constexpr Entry_t Class(const char* m_pClass, Unity::il2cppClass** m_pTarget)
+		{
+			return { m_eEntryType::Class, GetId(m_pClass, nullptr), m_pClass, nullptr, -1, m_pTarget };
+		}
+
+		constexpr Entry_t SystemType(const char* m_pClass)
+		{
+			return { m_eEntryType::SystemType, GetId(m_pClass, nullptr), m_pClass, nullptr, -1, nullptr };
+		}
+
+		constexpr Entry_t Method(const char* m_pClass, const char* m_pName, int m_iArgs, void** m_pTarget)
+		{
+			return { m_eEntryType::Method, GetId(m_pClass, m_pName), m_pClass, m_pName, m_iArgs, m_pTarget };
+		}
+
+		constexpr Entry_t Field(const char* m_pClass, const char* m_pName, int* m_pTarget)
+		{
+			return { m_eEntryType::Field, GetId(m_pClass, m_pName), m_pClass, m_pName, -1, m_pTarget };
+		}
+
+		constexpr Entry_t ICall(const char* m_pSignature, void** m_pTarget)
+		{
+			return { m_eEntryType::ICall, GetId(m_pSignature, nullptr), nullptr, m_pSignature, -1, m_pTarget };
+		}
+
+		struct Result_t
+		{
+			const Entry_t* m_pEntry = nullptr;
+			bool m_bResolved = false;
+			uint64_t m_uNanoseconds = 0U;
+		};
+
+		struct Report_t
+		{
+			std::vector<Result_t> m_Results;	// In registration order
+			size_t m_uFailed = 0U;
+			uint64_t m_uNanoseconds = 0U;
+		};
+
+		std::vector<std::pair<const Entry_t*, size_t>> m_Tables;
+		Report_t m_LastReport;
+
+		template<size_t N>
+		void Register(const Entry_t (&m_Entries)[N])
+		{
+			for (const auto& m_Table : m_Tables)
+			{
+				if (m_Table.first == m_Entries)
+					return;
+			}
+
+			m_Tables.emplace_back(m_Entries, N);
+		}
+
+		// Resolves one entry into its target, returns whether it was found.
+		bool ResolveEntry(const Entry_t& m_Entry)
+		{
+			switch (m_Entry.m_eType)
+			{
+				case m_eEntryType::ICall:
+				{
+					void* m_pCall = ResolveCall(m_Entry.m_pName);
+					*reinterpret_cast<void**>(m_Entry.m_pTarget) = m_pCall;
+					return m_pCall != nullptr;
+				}
+				case m_eEntryType::SystemType:
+				{
+					Unity::il2cppObject* m_pSystemType = Class::GetSystemType(m_Entry.m_pClass);
+					SystemTypeCache::Add(m_Entry.m_pClass, m_pSystemType);
+					return m_pSystemType != nullptr;
+				}
+				default: break;
+			}
+
+			Unity::il2cppClass* m_pClass = Class::Find(m_Entry.m_pClass);
+			switch (m_Entry.m_eType)
+			{
+				case m_eEntryType::Class:
+				{
+					*reinterpret_cast<Unity::il2cppClass**>(m_Entry.m_pTarget) = m_pClass;
+					return m_pClass != nullptr;
+				}
+				case m_eEntryType::Method:
+				{
+					void* m_pMethod = m_pClass ? Class::Utils::GetMethodPointer(m_pClass, m_Entry.m_pName, m_Entry.m_iArgs) : nullptr;
+					*reinterpret_cast<void**>(m_Entry.m_pTarget) = m_pMethod;
+					return m_pMethod != nullptr;
+				}
+				case m_eEntryType::Field:
+				{
+					int m_iOffset = m_pClass ? Class::Utils::GetFieldOffset(m_pClass, m_Entry.m_pName) : -1;
+					*reinterpret_cast<int*>(m_Entry.m_pTarget) = m_iOffset;
+					return m_iOffset >= 0;
+				}
+				default: return false;
+			}
+		}
+
+		// "Class::Name", "Class" or the icall signature, for reports.
+		std::string GetName(const Entry_t& m_Entry)
+		{
+			std::string m_Name = m_Entry.m_pClass ? m_Entry.m_pClass : "";
+			if (m_Entry.m_pClass && m_Entry.m_pName)
+				m_Name += "::";
+
+			if (m_Entry.m_pName)
+				m_Name += m_Entry.m_pName;
+
+			return m_Name;
+		}
+
+		bool IsSame(const Entry_t& m_Left, const Entry_t& m_Right)
+		{
+			auto m_Equal = [](const char* m_pLeft, const char* m_pRight) { return m_pLeft == m_pRight || (m_pLeft && m_pRight && strcmp(m_pLeft, m_pRight) == 0); };
+			return m_Left.m_eType == m_Right.m_eType && m_Left.m_iArgs == m_Right.m_iArgs && m_Equal(m_Left.m_pClass, m_Right.m_pClass) && m_Equal(m_Left.m_pName, m_Right.m_pName);
+		}
+
+		// Resolves every registered entry, duplicates by id are resolved once and copied.
+		const Report_t& Resolve()
+		{
+			auto m_Now = []() { return std::chrono::steady_clock::now(); };
+			auto m_Elapsed = [](std::chrono::steady_clock::time_point m_Start, std::chrono::steady_clock::time_point m_End)
+			{
+				return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(m_End - m_Start).count());
+			};
+
+			Report_t m_Report;
+			std::unordered_map<uint32_t, const Result_t*> m_Resolved;
+			for (const auto& m_Table : m_Tables)
+				m_Report.m_Results.reserve(m_Report.m_Results.size() + m_Table.second);
+
+			auto m_PassStart = m_Now();
+			for (const auto& m_Table : m_Tables)
+			{
+				for (size_t i = 0U; m_Table.second > i; ++i)
+				{
+					const Entry_t& m_Entry = m_Table.first[i];
+					Result_t m_Result;
+					m_Result.m_pEntry = &m_Entry;
+
+					auto m_Existing = m_Resolved.find(m_Entry.m_uId);
+					if (m_Existing != m_Resolved.end() && IsSame(*m_Existing->second->m_pEntry, m_Entry))
+					{
+						const Entry_t& m_Source = *m_Existing->second->m_pEntry;
+						if (m_Entry.m_pTarget && m_Source.m_pTarget && m_Entry.m_pTarget != m_Source.m_pTarget)
+							memcpy(m_Entry.m_pTarget, m_Source.m_pTarget, m_Entry.m_eType == m_eEntryType::Field ? sizeof(int) : sizeof(void*));
+
+						m_Result.m_bResolved = m_Existing->second->m_bResolved;
+					}
+					else
+					{
+						auto m_Start = m_Now();
+						m_Result.m_bResolved = ResolveEntry(m_Entry);
+						auto m_End = m_Now();
+						m_Result.m_uNanoseconds = m_Elapsed(m_Start, m_End);
+
+						if (StartupProfiler::Instance().IsEnabled())
+							StartupProfiler::Instance().Record("IL2CPP::Manifest", GetName(m_Entry), m_Start, m_End, StartupProfiler::CurrentDepth() + 1U);
+					}
+
+					if (!m_Result.m_bResolved)
+						++m_Report.m_uFailed;
+
+					m_Report.m_Results.emplace_back(m_Result);
+					m_Resolved.emplace(m_Entry.m_uId, &m_Report.m_Results.back());
+				}
+			}
+
+			auto m_PassEnd = m_Now();
+			m_Report.m_uNanoseconds = m_Elapsed(m_PassStart, m_PassEnd);
+			StartupProfiler::Instance().Record("IL2CPP::Manifest", {}, m_PassStart, m_PassEnd);
+			m_LastReport = std::move(m_Report);
+			return m_LastReport;
+		}
+
+		// Logs the failed entries and the m_uSlowest slowest ones of the last Resolve().
+		void LogReport(size_t m_uSlowest = 5U)
+		{
+			LOG_INFOS("manifest: %zu entries, %zu failed, %.3f ms", m_LastReport.m_Results.size(), m_LastReport.m_uFailed, m_LastReport.m_uNanoseconds / 1e6);
+
+			std::vector<const Result_t*> m_Sorted;
+			for (const Result_t& m_Result : m_LastReport.m_Results)
+			{
+				const Entry_t& m_Entry = *m_Result.m_pEntry;
+				if (!m_Result.m_bResolved)
+					LOG_INFOS("manifest: unresolved %s", GetName(m_Entry).c_str());
+
+				m_Sorted.emplace_back(&m_Result);
+			}
+
+			m_uSlowest = (std::min)(m_uSlowest, m_Sorted.size());
+			std::partial_sort(m_Sorted.begin(), m_Sorted.begin() + m_uSlowest, m_Sorted.end(), [](const Result_t* m_pLeft, const Result_t* m_pRight) { return m_pLeft->m_uNanoseconds > m_pRight->m_uNanoseconds; });
+			for (size_t i = 0U; m_uSlowest > i; ++i)
+				LOG_INFOS("manifest: %.3f ms %s", m_Sorted[i]->m_uNanoseconds / 1e6, GetName(*m_Sorted[i]->m_pEntry).c_str());
+		}
+	}
+}
@@ -15,6 +15,69 @@ namespace IL2CPP
 			//reinterpret_cast<void(IL2CPP_CALLING_CONVENTION)(void*)>(Functions.m_ThreadDetach)(m_Thread);
             il2cpp_thread_detach ((Il2CppThread *) m_Thread);
 		}
+
+		struct AttachStats_t
+		{
+			std::atomic<uint64_t> m_uAttached = { 0 };
+			std::atomic<uint64_t> m_uAdopted = { 0 };
+			std::atomic<uint64_t> m_uReused = { 0 };
+			std::atomic<uint64_t> m_uDetached = { 0 };
+		};
+		AttachStats_t m_AttachStats;
+
+		// Attached on first use per thread, detached when the thread exits.
+		struct CAttachment
+		{
+			void* m_pThread = nullptr;
+			bool m_bOwned = false;
+
+			void Release()
+			{
+				if (m_bOwned && m_pThread)
+				{
+					Detach(m_pThread);
+					m_AttachStats.m_uDetached.fetch_add(1, std::memory_order_relaxed);
+				}
+
+				m_pThread = nullptr;
+				m_bOwned = false;
+			}
+
+			~CAttachment() { Release(); }
+		};
+
+		CAttachment& GetAttachment()
+		{
+			thread_local CAttachment m_Attachment;
+			return m_Attachment;
+		}
+
+		void* AttachCurrent()
+		{
+			CAttachment& m_Attachment = GetAttachment();
+			if (m_Attachment.m_pThread)
+			{
+				m_AttachStats.m_uReused.fetch_add(1, std::memory_order_relaxed);
+				return m_Attachment.m_pThread;
+			}
+
+			m_Attachment.m_pThread = il2cpp_thread_current();
+			if (m_Attachment.m_pThread)
+			{
+				m_AttachStats.m_uAdopted.fetch_add(1, std::memory_order_relaxed);
+				return m_Attachment.m_pThread;
+			}
+
+			m_Attachment.m_pThread = Attach(Domain::Get());
+			m_Attachment.m_bOwned = (m_Attachment.m_pThread != nullptr);
+			m_AttachStats.m_uAttached.fetch_add(1, std::memory_order_relaxed);
+			return m_Attachment.m_pThread;
+		}
+
+		void DetachCurrent()
+		{
+			GetAttachment().Release();
+		}
 	}
 
 	// Our Stuff
@@ -24,7 +87,7 @@ namespace IL2CPP
 		void* m_OnStart = nullptr;
 		void* m_OnEnd = nullptr;
 
-		static unsigned int  Handler(void* m_Reserved)
+		static void* Handler(void* m_Reserved)
 		{
 			void* m_IL2CPPThread = Thread::Attach(Domain::Get());
 
@@ -38,7 +101,7 @@ namespace IL2CPP
 				reinterpret_cast<void(*)()>(m_ThreadEnd)();
 
 			Thread::Detach(m_IL2CPPThread);
-			return 0x0;
+			return nullptr;
 		}
 
 		CThread() { /* Why would you even do this? */ }
@@ -46,18 +109,195 @@ namespace IL2CPP
 		{
 			m_OnStart	= m_OnStartFunc;
 			m_OnEnd		= m_OnEndFunc;
+		}
 
+		// Runs the thread detached, the handler frees this object.
+		bool Start()
+		{
 			if (!m_OnStart)
 			{
-				IL2CPP_ASSERT("IL2CPP::CThread - m_OnStart is nullptr");
-				return;
+				IL2CPP_ASSERT(!"IL2CPP::CThread - m_OnStart is nullptr");
+				return false;
+			}
+
+			pthread_t m_Thread;
+			if (pthread_create(&m_Thread, nullptr, Handler, this) != 0)
+				return false;
+
+			pthread_detach(m_Thread);
+			return true;
+		}
+	};
+
+	// Fixed set of pthread workers for il2cpp work off the main thread (heap scans, dumps,
+	// metadata walks). Each worker attaches to il2cpp once and stays attached until the pool
+	// stops. Every worker owns a deque: it pops its own work LIFO and steals FIFO from the others
+	// when empty. Submit() from a worker goes to that worker's deque, from elsewhere round-robin.
+	class CThreadPool
+	{
+	public:
+		explicit CThreadPool(size_t m_sWorkers = 0U)
+		{
+			if (!m_sWorkers)
+			{
+				unsigned int m_uCores = std::thread::hardware_concurrency();
+				m_sWorkers = m_uCores > 2U ? m_uCores - 1U : 1U;
+			}
+
+			for (size_t i = 0U; m_sWorkers > i; ++i)
+				m_vWorkers.emplace_back(new Worker_t());
+
+			for (size_t i = 0U; m_sWorkers > i; ++i)
+			{
+				m_vWorkers[i]->m_pPool = this;
+				m_vWorkers[i]->m_sIndex = i;
+				m_vWorkers[i]->m_bStarted = pthread_create(&m_vWorkers[i]->m_Thread, nullptr, Run, m_vWorkers[i].get()) == 0;
+			}
+		}
+
+		CThreadPool(const CThreadPool&) = delete;
+		CThreadPool& operator=(const CThreadPool&) = delete;
+
+		~CThreadPool() { Stop(); }
+
+		template<typename F>
+		std::future<decltype(std::declval<F>()())> Submit(F&& m_fTask)
+		{
+			using Result_t = decltype(std::declval<F>()());
+
+			auto m_pTask = std::make_shared<std::packaged_task<Result_t()>>(std::forward<F>(m_fTask));
+			std::future<Result_t> m_Future = m_pTask->get_future();
+
+			Worker_t* m_pWorker = GetCurrentWorker();
+			if (!m_pWorker || m_pWorker->m_pPool != this)
+				m_pWorker = m_vWorkers[m_sNext.fetch_add(1, std::memory_order_relaxed) % m_vWorkers.size()].get();
+
+			// Checked and queued under m_WaitMutex so no worker can exit between the two.
+			bool m_bQueued = false;
+			{
+				std::lock_guard<std::mutex> m_Lock(m_WaitMutex);
+				if (!m_bStop)
+				{
+					m_sPending.fetch_add(1, std::memory_order_release);
+					std::lock_guard<std::mutex> m_QueueLock(m_pWorker->m_Mutex);
+					m_pWorker->m_Queue.emplace_back([m_pTask]() { (*m_pTask)(); });
+					m_bQueued = true;
+				}
+			}
+
+			if (!m_bQueued)
+			{
+				// Stopped, no worker would pick it up.
+				(*m_pTask)();
+				return m_Future;
+			}
+
+			m_Wake.notify_one();
+			return m_Future;
+		}
+
+		// Runs what is already queued, then joins the workers. Tasks submitted afterwards run
+		// inline on the submitting thread.
+		void Stop()
+		{
+			{
+				std::lock_guard<std::mutex> m_Lock(m_WaitMutex);
+				if (m_bStop)
+					return;
+
+				m_bStop = true;
+			}
+			m_Wake.notify_all();
+
+			for (std::unique_ptr<Worker_t>& m_pWorker : m_vWorkers)
+			{
+				if (m_pWorker->m_bStarted)
+					pthread_join(m_pWorker->m_Thread, nullptr);
 			}
+		}
+
+		size_t GetWorkerCount() const { return m_vWorkers.size(); }
 
-            // TODO:
-			// HANDLE m_Thread = CreateThread(0, 0, Handler, this, 0, 0);
-			// if (m_Thread)
-			// 	CloseHandle(m_Thread);
+		size_t GetPendingCount() const { return m_sPending.load(std::memory_order_relaxed); }
+
+	private:
+		struct Worker_t
+		{
+			CThreadPool* m_pPool = nullptr;
+			size_t m_sIndex = 0U;
+			pthread_t m_Thread;
+			bool m_bStarted = false;
+			std::mutex m_Mutex;
+			std::deque<std::function<void()>> m_Queue;
+		};
+
+		static Worker_t*& GetCurrentWorker()
+		{
+			thread_local Worker_t* m_pWorker = nullptr;
+			return m_pWorker;
 		}
+
+		static void* Run(void* m_pArg)
+		{
+			Worker_t* m_pWorker = reinterpret_cast<Worker_t*>(m_pArg);
+			CThreadPool* m_pPool = m_pWorker->m_pPool;
+			GetCurrentWorker() = m_pWorker;
+			Thread::AttachCurrent();
+
+			std::function<void()> m_fTask;
+			while (1)
+			{
+				if (m_pPool->Pop(m_pWorker->m_sIndex, m_fTask))
+				{
+					m_fTask();
+					m_fTask = nullptr;
+					continue;
+				}
+
+				std::unique_lock<std::mutex> m_Lock(m_pPool->m_WaitMutex);
+				m_pPool->m_Wake.wait(m_Lock, [m_pPool]() { return m_pPool->m_bStop || m_pPool->m_sPending.load(std::memory_order_acquire); });
+				if (m_pPool->m_bStop && !m_pPool->m_sPending.load(std::memory_order_acquire))
+					break;
+			}
+
+			Thread::DetachCurrent();
+			GetCurrentWorker() = nullptr;
+			return nullptr;
+		}
+
+		bool Pop(size_t m_sSelf, std::function<void()>& m_fTask)
+		{
+			for (size_t i = 0U; m_vWorkers.size() > i; ++i)
+			{
+				Worker_t* m_pWorker = m_vWorkers[(m_sSelf + i) % m_vWorkers.size()].get();
+				std::lock_guard<std::mutex> m_Lock(m_pWorker->m_Mutex);
+				if (m_pWorker->m_Queue.empty())
+					continue;
+
+				if (i == 0U)
+				{
+					m_fTask = std::move(m_pWorker->m_Queue.back());
+					m_pWorker->m_Queue.pop_back();
+				}
+				else
+				{
+					m_fTask = std::move(m_pWorker->m_Queue.front());
+					m_pWorker->m_Queue.pop_front();
+				}
+
+				m_sPending.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			return false;
+		}
+
+		std::vector<std::unique_ptr<Worker_t>> m_vWorkers;
+		std::atomic<size_t> m_sNext = { 0U };
+		std::atomic<size_t> m_sPending = { 0U };
+		std::mutex m_WaitMutex;
+		std::condition_variable m_Wake;
+		bool m_bStop = false;
 	};
 
 	namespace Thread
@@ -65,7 +305,24 @@ namespace IL2CPP
 		void Create(void* m_OnStartFunc, void* m_OnEndFunc = nullptr)
 		{
 			CThread* m_Thread = new CThread(m_OnStartFunc, m_OnEndFunc);
-			IL2CPP_ASSERT(m_Thread && "IL2CPP::Thread::Create - Failed!");
+			if (!m_Thread->Start())
+			{
+				IL2CPP_ASSERT(!"IL2CPP::Thread::Create - Failed!");
+				delete m_Thread;
+			}
+		}
+
+		// Shared pool, started on first use.
+		CThreadPool& GetPool()
+		{
+			static CThreadPool m_Pool;
+			return m_Pool;
+		}
+
+		template<typename F>
+		std::future<decltype(std::declval<F>()())> Submit(F&& m_fTask)
+		{
+			return GetPool().Submit(std::forward<F>(m_fTask));
 		}
 	}
 }
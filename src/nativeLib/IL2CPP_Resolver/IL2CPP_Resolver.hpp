@@ -7,8 +7,31 @@
 #include <math.h>
 #include <vector>
 #include <unordered_map>
+#include <atomic>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#if __cplusplus >= 202002L
+	#include <span>
+#endif
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
 // #include <Windows.h>
 
+#include "StartupProfiler.hpp"
+
 // Application Defines
 #ifndef UNITY_VERSION_2022_3_8F1
 	// If Unity version is equal or greater than 2022.3.8f1 uncomment this define.
@@ -50,6 +73,7 @@
 
 // IL2CPP Utils
 #include "Utils/Hash.hpp"
+#include "Utils/FlatHashMap.hpp"
 #include "Utils/VTable.hpp"
 
 // IL2CPP API Headers
@@ -61,6 +85,7 @@
 
 // IL2CPP Headers before Unity API
 #include "SystemTypeCache.hpp"
+#include "API/Manifest.hpp"
 
 // Unity Class APIs - So they're accessible everywhere
 namespace Unity
@@ -187,6 +212,8 @@ namespace IL2CPP
 //					return false;
 //			}
 
+			StartupProfiler::Scope m_Profile("IL2CPP::Initialize");
+
 			// Unity APIs
 			Unity::Camera::Initialize();
 			Unity::Component::Initialize();
@@ -196,8 +223,15 @@ namespace IL2CPP
 			Unity::RigidBody::Initialize();
 			Unity::Transform::Initialize();
 
+			// Everything registered so far, including manifests of modules initialized before us.
+			if (IL2CPP::Manifest::Resolve().m_uFailed)
+				IL2CPP::Manifest::LogReport();
+
 			// Caches
-			IL2CPP::SystemTypeCache::Initializer::PreCache();
+			{
+				StartupProfiler::Scope m_ProfilePreCache("IL2CPP::SystemTypeCache::PreCache");
+				IL2CPP::SystemTypeCache::Initializer::PreCache();
+			}
 
 			return true;
 		}
@@ -236,32 +270,15 @@ namespace IL2CPP
 
     void listGameObjects() {
 
-        Unity::il2cppArray<Unity::CGameObject*>* m_Objects = Unity::Object::FindObjectsOfType<Unity::CGameObject>(UNITY_GAMEOBJECT_CLASS);
-        LOG_INFOS(" find %d", m_Objects->m_uMaxLength);
-        for (uintptr_t u = 0U; m_Objects->m_uMaxLength > u; ++u)
+        auto m_Start = std::chrono::steady_clock::now();
+        size_t m_sObjects = Helper::EnumerateGameObjects([](const Helper::GameObjectRecord_t& m_Record)
         {
-            Unity::CGameObject* obj = m_Objects->operator[](static_cast<unsigned int>(u));
-            if (!obj) continue;
-
-            auto* system_string = obj->GetName();
-            if (!system_string) continue;
-
-            std::string s = system_string->ToString();
-
-			auto* clzName = obj->m_Object.m_pClass->m_pName;
-
-            Unity::il2cppArray<Unity::CComponent*>* m_pComponents = obj->GetComponents("UnityEngine.Component");
-
-            LOG_INFOS(" %s(%s)%d", s.c_str(), clzName, m_pComponents->m_uMaxLength);
-            for (uintptr_t uu = 0U; m_pComponents->m_uMaxLength > uu; ++uu)
-            {
-                Unity::CComponent* m_pComponent = m_pComponents->operator[](static_cast<unsigned int>(uu));
-			    auto* clzName1 = m_pComponent->m_Object.m_pClass->m_pName;
-                LOG_INFOS("     %s(%s) ", m_pComponent->GetName()->ToString().c_str(), clzName1);
-            }
-
-        }
+            LOG_INFOS(" %s(%s)%zu", m_Record.m_pName, m_Record.m_pClass->m_pName, m_Record.m_sComponents);
+            for (size_t i = 0U; m_Record.m_sComponents > i; ++i)
+                LOG_INFOS("     %s(%s) ", m_Record.m_pName, m_Record.m_pComponents[i].m_pClass->m_pName);
+        });
 
+        LOG_INFOS(" find %zu in %.3f ms", m_sObjects, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_Start).count());
     }
 }
 
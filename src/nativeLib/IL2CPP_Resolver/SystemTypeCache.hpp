@@ -4,26 +4,38 @@ namespace IL2CPP
 {
 	namespace SystemTypeCache
 	{
-		std::unordered_map<uint32_t, Unity::il2cppObject*> m_Map;
+		// Lookups by name verify the full name, lookups by hash alone cannot. A miss no longer inserts anything.
+		Utils::CFlatHashMap<std::atomic<Unity::il2cppObject*>> m_Map(256);
+
+		void Add(uint32_t m_Hash, const char* m_Name, Unity::il2cppObject* m_SystemType)
+		{
+			m_Map.Insert(m_Hash, m_Hash, m_Name, [](std::atomic<Unity::il2cppObject*>&) {})->store(m_SystemType, std::memory_order_release);
+		}
 
 		void Add(uint32_t m_Hash, Unity::il2cppObject* m_SystemType)
 		{
-			m_Map[m_Hash] = m_SystemType;
+			Add(m_Hash, nullptr, m_SystemType);
 		}
 
 		void Add(const char* m_Name, Unity::il2cppObject* m_SystemType)
 		{
-			Add(Utils::Hash::Get(m_Name), m_SystemType);
+			Add(Utils::Hash::Get(m_Name), m_Name, m_SystemType);
+		}
+
+		Unity::il2cppObject* Get(uint32_t m_Hash, const char* m_Name)
+		{
+			std::atomic<Unity::il2cppObject*>* m_pEntry = m_Map.Find(m_Hash, m_Hash, m_Name);
+			return m_pEntry ? m_pEntry->load(std::memory_order_acquire) : nullptr;
 		}
 
 		Unity::il2cppObject* Get(uint32_t m_Hash)
 		{
-			return m_Map[m_Hash];
+			return Get(m_Hash, nullptr);
 		}
 
 		Unity::il2cppObject* Get(const char* m_Name)
 		{
-			return Get(Utils::Hash::Get(m_Name));
+			return Get(Utils::Hash::Get(m_Name), m_Name);
 		}
 
 		// Legacy Naming
@@ -49,7 +61,10 @@ namespace IL2CPP
 			void PreCache()
 			{
 				for (const char* m_Name : m_List)
+				{
+					StartupProfiler::Scope m_Profile("IL2CPP::SystemTypeCache::PreCache", m_Name);
 					SystemTypeCache::Add(m_Name, IL2CPP::Class::GetSystemType(m_Name));
+				}
 
 				m_List.clear();
 			}
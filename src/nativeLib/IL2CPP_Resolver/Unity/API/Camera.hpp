@@ -45,17 +45,21 @@ namespace Unity
 
 	namespace Camera
 	{
-		void Initialize()
+		IL2CPP_MANIFEST_STORAGE IL2CPP::Manifest::Entry_t m_Manifest[] =
 		{
-			IL2CPP::SystemTypeCache::Initializer::Add(UNITY_CAMERA_CLASS);
+			IL2CPP::Manifest::SystemType(UNITY_CAMERA_CLASS),
+			IL2CPP::Manifest::ICall(UNITY_CAMERA_GETCURRENT, &m_CameraFunctions.m_GetCurrent),
+			IL2CPP::Manifest::ICall(UNITY_CAMERA_GETMAIN, &m_CameraFunctions.m_GetMain),
+			IL2CPP::Manifest::ICall(UNITY_CAMERA_GETDEPTH, &m_CameraFunctions.m_GetDepth),
+			IL2CPP::Manifest::ICall(UNITY_CAMERA_SETDEPTH, &m_CameraFunctions.m_SetDepth),
+			IL2CPP::Manifest::ICall(UNITY_CAMERA_GETFIELDOFVIEW, &m_CameraFunctions.m_GetFieldOfView),
+			IL2CPP::Manifest::ICall(UNITY_CAMERA_SETFIELDOFVIEW, &m_CameraFunctions.m_SetFieldOfView),
+			IL2CPP::Manifest::ICall(UNITY_CAMERA_WORLDTOSCREEN, &m_CameraFunctions.m_WorldToScreen),
+		};
 
-			m_CameraFunctions.m_GetCurrent		= IL2CPP::ResolveCall(UNITY_CAMERA_GETCURRENT);
-			m_CameraFunctions.m_GetMain			= IL2CPP::ResolveCall(UNITY_CAMERA_GETMAIN);
-			m_CameraFunctions.m_GetDepth		= IL2CPP::ResolveCall(UNITY_CAMERA_GETDEPTH);
-			m_CameraFunctions.m_SetDepth		= IL2CPP::ResolveCall(UNITY_CAMERA_SETDEPTH);
-			m_CameraFunctions.m_GetFieldOfView	= IL2CPP::ResolveCall(UNITY_CAMERA_GETFIELDOFVIEW);
-			m_CameraFunctions.m_SetFieldOfView	= IL2CPP::ResolveCall(UNITY_CAMERA_SETFIELDOFVIEW);
-			m_CameraFunctions.m_WorldToScreen	= IL2CPP::ResolveCall(UNITY_CAMERA_WORLDTOSCREEN);
+		void Initialize()
+		{
+			IL2CPP::Manifest::Register(m_Manifest);
 		}
 
 		CCamera* GetCurrent()
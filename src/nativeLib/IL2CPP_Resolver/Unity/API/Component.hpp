@@ -25,12 +25,16 @@ namespace Unity
 
 	namespace Component
 	{
-		void Initialize()
+		IL2CPP_MANIFEST_STORAGE IL2CPP::Manifest::Entry_t m_Manifest[] =
 		{
-			IL2CPP::SystemTypeCache::Initializer::Add(UNITY_COMPONENT_CLASS);
+			IL2CPP::Manifest::SystemType(UNITY_COMPONENT_CLASS),
+			IL2CPP::Manifest::ICall(UNITY_COMPONENT_GETGAMEOBJECT, &m_ComponentFunctions.m_GetGameObject),
+			IL2CPP::Manifest::ICall(UNITY_COMPONENT_GETTRANSFORM, &m_ComponentFunctions.m_GetTransform),
+		};
 
-			m_ComponentFunctions.m_GetGameObject	= IL2CPP::ResolveCall(UNITY_COMPONENT_GETGAMEOBJECT);
-			m_ComponentFunctions.m_GetTransform		= IL2CPP::ResolveCall(UNITY_COMPONENT_GETTRANSFORM);
+		void Initialize()
+		{
+			IL2CPP::Manifest::Register(m_Manifest);
 		}
 	}
 }
\ No newline at end of file
@@ -126,22 +126,26 @@ namespace Unity
 			Quad,
 		};
 
+		IL2CPP_MANIFEST_STORAGE IL2CPP::Manifest::Entry_t m_Manifest[] =
+		{
+			IL2CPP::Manifest::SystemType(UNITY_GAMEOBJECT_CLASS),
+			IL2CPP::Manifest::ICall(UNITY_GAMEOBJECT_ADDCOMPONENT, &m_GameObjectFunctions.m_AddComponent),
+			IL2CPP::Manifest::ICall(UNITY_GAMEOBJECT_CREATEPRIMITIVE, &m_GameObjectFunctions.m_CreatePrimitive),
+			IL2CPP::Manifest::ICall(UNITY_GAMEOBJECT_FIND, &m_GameObjectFunctions.m_Find),
+			IL2CPP::Manifest::ICall(UNITY_GAMEOBJECT_FINDGAMEOBJECTWITHTAG, &m_GameObjectFunctions.m_FindGameObjectsWithTag),
+			IL2CPP::Manifest::ICall(UNITY_GAMEOBJECT_GETCOMPONENT, &m_GameObjectFunctions.m_GetComponent),
+			IL2CPP::Manifest::ICall(UNITY_GAMEOBJECT_GETCOMPONENTS, &m_GameObjectFunctions.m_GetComponents),
+			IL2CPP::Manifest::ICall(UNITY_GAMEOBJECT_GETCOMPONENTINCHILDREN, &m_GameObjectFunctions.m_GetComponentInChildren),
+			IL2CPP::Manifest::ICall(UNITY_GAMEOBJECT_GETACTIVE, &m_GameObjectFunctions.m_GetActive),
+			IL2CPP::Manifest::ICall(UNITY_GAMEOBJECT_GETLAYER, &m_GameObjectFunctions.m_GetLayer),
+			IL2CPP::Manifest::ICall(UNITY_GAMEOBJECT_GETTRANSFORM, &m_GameObjectFunctions.m_GetTransform),
+			IL2CPP::Manifest::ICall(UNITY_GAMEOBJECT_SETACTIVE, &m_GameObjectFunctions.m_SetActive),
+			IL2CPP::Manifest::ICall(UNITY_GAMEOBJECT_SETLAYER, &m_GameObjectFunctions.m_SetLayer),
+		};
+
 		void Initialize()
 		{
-			IL2CPP::SystemTypeCache::Initializer::Add(UNITY_GAMEOBJECT_CLASS);
-
-			m_GameObjectFunctions.m_AddComponent			= IL2CPP::ResolveCall(UNITY_GAMEOBJECT_ADDCOMPONENT);
-			m_GameObjectFunctions.m_CreatePrimitive			= IL2CPP::ResolveCall(UNITY_GAMEOBJECT_CREATEPRIMITIVE);
-			m_GameObjectFunctions.m_Find					= IL2CPP::ResolveCall(UNITY_GAMEOBJECT_FIND);
-			m_GameObjectFunctions.m_FindGameObjectsWithTag	= IL2CPP::ResolveCall(UNITY_GAMEOBJECT_FINDGAMEOBJECTWITHTAG);
-			m_GameObjectFunctions.m_GetComponent			= IL2CPP::ResolveCall(UNITY_GAMEOBJECT_GETCOMPONENT);
-			m_GameObjectFunctions.m_GetComponents			= IL2CPP::ResolveCall(UNITY_GAMEOBJECT_GETCOMPONENTS);
-			m_GameObjectFunctions.m_GetComponentInChildren	= IL2CPP::ResolveCall(UNITY_GAMEOBJECT_GETCOMPONENTINCHILDREN);
-			m_GameObjectFunctions.m_GetActive				= IL2CPP::ResolveCall(UNITY_GAMEOBJECT_GETACTIVE);
-			m_GameObjectFunctions.m_GetLayer				= IL2CPP::ResolveCall(UNITY_GAMEOBJECT_GETLAYER);
-			m_GameObjectFunctions.m_GetTransform			= IL2CPP::ResolveCall(UNITY_GAMEOBJECT_GETTRANSFORM);
-			m_GameObjectFunctions.m_SetActive				= IL2CPP::ResolveCall(UNITY_GAMEOBJECT_SETACTIVE);
-			m_GameObjectFunctions.m_SetLayer				= IL2CPP::ResolveCall(UNITY_GAMEOBJECT_SETLAYER);
+			IL2CPP::Manifest::Register(m_Manifest);
 		}
 
 		CGameObject* CreatePrimitive(m_ePrimitiveType m_Type)
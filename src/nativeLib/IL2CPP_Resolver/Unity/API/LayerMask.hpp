@@ -11,12 +11,16 @@ namespace Unity
 
 	namespace LayerMask
 	{
-		void Initialize()
+		IL2CPP_MANIFEST_STORAGE IL2CPP::Manifest::Entry_t m_Manifest[] =
 		{
-			IL2CPP::SystemTypeCache::Initializer::Add(UNITY_LAYERMASK_CLASS);
+			IL2CPP::Manifest::SystemType(UNITY_LAYERMASK_CLASS),
+			IL2CPP::Manifest::ICall(UNITY_LAYERMASK_LAYERTONAME, &m_LayerMaskFunctions.m_LayerToName),
+			IL2CPP::Manifest::ICall(UNITY_LAYERMASK_NAMETOLAYER, &m_LayerMaskFunctions.m_NameToLayer),
+		};
 
-			m_LayerMaskFunctions.m_LayerToName = IL2CPP::ResolveCall(UNITY_LAYERMASK_LAYERTONAME);
-			m_LayerMaskFunctions.m_NameToLayer = IL2CPP::ResolveCall(UNITY_LAYERMASK_NAMETOLAYER);
+		void Initialize()
+		{
+			IL2CPP::Manifest::Register(m_Manifest);
 		}
 
 		System_String* LayerToName(unsigned int m_uLayer)
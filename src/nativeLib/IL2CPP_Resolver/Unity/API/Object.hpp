@@ -26,13 +26,17 @@ namespace Unity
 
 	namespace Object
 	{
-		void Initialize()
+		IL2CPP_MANIFEST_STORAGE IL2CPP::Manifest::Entry_t m_Manifest[] =
 		{
-			IL2CPP::SystemTypeCache::Initializer::Add(UNITY_OBJECT_CLASS);
+			IL2CPP::Manifest::SystemType(UNITY_OBJECT_CLASS),
+			IL2CPP::Manifest::ICall(UNITY_OBJECT_DESTROY, &m_ObjectFunctions.m_Destroy),
+			IL2CPP::Manifest::ICall(UNITY_OBJECT_FINDOBJECTSOFTYPE, &m_ObjectFunctions.m_FindObjectsOfType),
+			IL2CPP::Manifest::ICall(UNITY_OBJECT_GETNAME, &m_ObjectFunctions.m_GetName),
+		};
 
-			m_ObjectFunctions.m_Destroy				= IL2CPP::ResolveCall(UNITY_OBJECT_DESTROY);
-			m_ObjectFunctions.m_FindObjectsOfType	= IL2CPP::ResolveCall(UNITY_OBJECT_FINDOBJECTSOFTYPE);
-			m_ObjectFunctions.m_GetName				= IL2CPP::ResolveCall(UNITY_OBJECT_GETNAME);
+		void Initialize()
+		{
+			IL2CPP::Manifest::Register(m_Manifest);
 		}
 
 		static il2cppObject* New(il2cppClass* m_pClass)
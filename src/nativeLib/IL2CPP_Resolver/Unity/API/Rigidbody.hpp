@@ -39,15 +39,18 @@ namespace Unity
 
 	namespace RigidBody
 	{
-		void Initialize()
+		IL2CPP_MANIFEST_STORAGE IL2CPP::Manifest::Entry_t m_Manifest[] =
 		{
-			IL2CPP::SystemTypeCache::Initializer::Add(UNITY_RIGIDBODY_CLASS);
-
-			m_RigidbodyFunctions.m_GetDetectCollisions	= IL2CPP::ResolveCall(UNITY_RIGIDBODY_GETDETECTCOLLISIONS);
-			m_RigidbodyFunctions.m_GetVelocity			= IL2CPP::ResolveCall(UNITY_RIGIDBODY_GETVELOCITY);
-			m_RigidbodyFunctions.m_SetDetectCollisions	= IL2CPP::ResolveCall(UNITY_RIGIDBODY_SETDETECTCOLLISIONS);
-			m_RigidbodyFunctions.m_SetVelocity			= IL2CPP::ResolveCall(UNITY_RIGIDBODY_SETVELOCITY);
+			IL2CPP::Manifest::SystemType(UNITY_RIGIDBODY_CLASS),
+			IL2CPP::Manifest::ICall(UNITY_RIGIDBODY_GETDETECTCOLLISIONS, &m_RigidbodyFunctions.m_GetDetectCollisions),
+			IL2CPP::Manifest::ICall(UNITY_RIGIDBODY_GETVELOCITY, &m_RigidbodyFunctions.m_GetVelocity),
+			IL2CPP::Manifest::ICall(UNITY_RIGIDBODY_SETDETECTCOLLISIONS, &m_RigidbodyFunctions.m_SetDetectCollisions),
+			IL2CPP::Manifest::ICall(UNITY_RIGIDBODY_SETVELOCITY, &m_RigidbodyFunctions.m_SetVelocity),
+		};
 
+		void Initialize()
+		{
+			IL2CPP::Manifest::Register(m_Manifest);
 		}
 	}
 }
\ No newline at end of file
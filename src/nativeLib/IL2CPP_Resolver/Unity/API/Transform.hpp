@@ -108,23 +108,27 @@ namespace Unity
 
 	namespace Transform
 	{
+		IL2CPP_MANIFEST_STORAGE IL2CPP::Manifest::Entry_t m_Manifest[] =
+		{
+			IL2CPP::Manifest::SystemType(UNITY_TRANSFORM_CLASS),
+			IL2CPP::Manifest::ICall(UNITY_TRANSFORM_GETPARENT, &m_TransformFunctions.m_GetParent),
+			IL2CPP::Manifest::ICall(UNITY_TRANSFORM_GETROOT, &m_TransformFunctions.m_GetRoot),
+			IL2CPP::Manifest::ICall(UNITY_TRANSFORM_GETCHILD, &m_TransformFunctions.m_GetChild),
+			IL2CPP::Manifest::ICall(UNITY_TRANSFORM_GETCHILDCOUNT, &m_TransformFunctions.m_GetChildCount),
+			IL2CPP::Manifest::ICall(UNITY_TRANSFORM_FINDCHILD, &m_TransformFunctions.m_FindChild),
+			IL2CPP::Manifest::ICall(UNITY_TRANSFORM_GETPOSITION, &m_TransformFunctions.m_GetPosition),
+			IL2CPP::Manifest::ICall(UNITY_TRANSFORM_GETROTATION, &m_TransformFunctions.m_GetRotation),
+			IL2CPP::Manifest::ICall(UNITY_TRANSFORM_GETLOCALPOSITION, &m_TransformFunctions.m_GetLocalPosition),
+			IL2CPP::Manifest::ICall(UNITY_TRANSFORM_GETLOCALSCALE, &m_TransformFunctions.m_GetLocalScale),
+			IL2CPP::Manifest::ICall(UNITY_TRANSFORM_SETPOSITION, &m_TransformFunctions.m_SetPosition),
+			IL2CPP::Manifest::ICall(UNITY_TRANSFORM_SETROTATION, &m_TransformFunctions.m_SetRotation),
+			IL2CPP::Manifest::ICall(UNITY_TRANSFORM_SETLOCALPOSITION, &m_TransformFunctions.m_SetLocalPosition),
+			IL2CPP::Manifest::ICall(UNITY_TRANSFORM_SETLOCALSCALE, &m_TransformFunctions.m_SetLocalScale),
+		};
+
 		void Initialize()
 		{
-			IL2CPP::SystemTypeCache::Initializer::Add(UNITY_TRANSFORM_CLASS);
-
-			m_TransformFunctions.m_GetParent		= IL2CPP::ResolveCall(UNITY_TRANSFORM_GETPARENT);
-			m_TransformFunctions.m_GetRoot			= IL2CPP::ResolveCall(UNITY_TRANSFORM_GETROOT);
-			m_TransformFunctions.m_GetChild			= IL2CPP::ResolveCall(UNITY_TRANSFORM_GETCHILD);
-			m_TransformFunctions.m_GetChildCount	= IL2CPP::ResolveCall(UNITY_TRANSFORM_GETCHILDCOUNT);
-			m_TransformFunctions.m_FindChild		= IL2CPP::ResolveCall(UNITY_TRANSFORM_FINDCHILD);
-			m_TransformFunctions.m_GetPosition		= IL2CPP::ResolveCall(UNITY_TRANSFORM_GETPOSITION);
-			m_TransformFunctions.m_GetRotation		= IL2CPP::ResolveCall(UNITY_TRANSFORM_GETROTATION);
-			m_TransformFunctions.m_GetLocalPosition = IL2CPP::ResolveCall(UNITY_TRANSFORM_GETLOCALPOSITION);
-			m_TransformFunctions.m_GetLocalScale	= IL2CPP::ResolveCall(UNITY_TRANSFORM_GETLOCALSCALE);
-			m_TransformFunctions.m_SetPosition		= IL2CPP::ResolveCall(UNITY_TRANSFORM_SETPOSITION);
-			m_TransformFunctions.m_SetRotation		= IL2CPP::ResolveCall(UNITY_TRANSFORM_SETROTATION);
-			m_TransformFunctions.m_SetLocalPosition = IL2CPP::ResolveCall(UNITY_TRANSFORM_SETLOCALPOSITION);
-			m_TransformFunctions.m_SetLocalScale	= IL2CPP::ResolveCall(UNITY_TRANSFORM_SETLOCALSCALE);
+			IL2CPP::Manifest::Register(m_Manifest);
 		}
 	}
 }
\ No newline at end of file
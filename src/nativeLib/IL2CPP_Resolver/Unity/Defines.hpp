@@ -59,6 +59,10 @@
 #define UNITY_RIGIDBODY_SETDETECTCOLLISIONS                         IL2CPP_RStr(UNITY_RIGIDBODY_CLASS"::set_detectCollisions")
 #define UNITY_RIGIDBODY_SETVELOCITY                                 IL2CPP_RStr(UNITY_RIGIDBODY_CLASS"::set_velocity_Injected")
 
+// Time
+#define UNITY_TIME_CLASS											"UnityEngine.Time"
+#define UNITY_TIME_GETFRAMECOUNT									IL2CPP_RStr(UNITY_TIME_CLASS"::get_frameCount")
+
 // Transform
 #define UNITY_TRANSFORM_CLASS										"UnityEngine.Transform"
 #define UNITY_TRANSFORM_GETPARENT                                   IL2CPP_RStr(UNITY_TRANSFORM_CLASS"::GetParent")
@@ -29,4 +29,42 @@ namespace Unity
 		    return sRet;
 		}
 	};
+
+	// String.GetHashCode of the non-randomized BCL. Dictionaries built with another comparer
+	// still resolve, the lookup then falls back to a scan.
+	template<>
+	struct il2cppKeyHasher<System_String*>
+	{
+		static constexpr bool m_bHashed = true;
+		static constexpr bool m_bExact = false;
+
+		static int Get(System_String* const& m_pKey)
+		{
+			if (!m_pKey)
+				return 0;
+
+			uint32_t m_uHash1 = 5381U, m_uHash2 = 5381U;
+			for (int i = 0; m_pKey->m_iLength > i; i += 2)
+			{
+				m_uHash1 = ((m_uHash1 << 5) + m_uHash1) ^ m_pKey->m_wString[i];
+				if (i + 1 >= m_pKey->m_iLength)
+					break;
+
+				m_uHash2 = ((m_uHash2 << 5) + m_uHash2) ^ m_pKey->m_wString[i + 1];
+			}
+
+			return static_cast<int>(m_uHash1 + m_uHash2 * 1566083941U);
+		}
+
+		static bool Equals(System_String* const& m_pLeft, System_String* const& m_pRight)
+		{
+			if (m_pLeft == m_pRight)
+				return true;
+
+			if (!m_pLeft || !m_pRight || m_pLeft->m_iLength != m_pRight->m_iLength)
+				return false;
+
+			return memcmp(m_pLeft->m_wString, m_pRight->m_wString, static_cast<size_t>(m_pLeft->m_iLength) * sizeof(char16_t)) == 0;
+		}
+	};
 }
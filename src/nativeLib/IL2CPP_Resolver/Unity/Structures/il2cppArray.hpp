@@ -24,6 +24,29 @@ namespace Unity
 			return operator[](m_uIndex);
 		}
 
+		// Contiguous storage, so plain pointers are the random-access iterators.
+		T* data() { return reinterpret_cast<T*>(GetData()); }
+		T* begin() { return data(); }
+		T* end() { return data() + m_uMaxLength; }
+		size_t size() const { return static_cast<size_t>(m_uMaxLength); }
+
+#if __cplusplus >= 202002L
+		std::span<T> AsSpan() { return std::span<T>(data(), size()); }
+		operator std::span<T>() { return AsSpan(); }
+#endif
+
+		// Elements that are object references were copied around the GC's back, tell it about
+		// every slot that now holds a new reference. Value types need nothing.
+		void WriteBarrier(uintptr_t m_uIndex, uintptr_t m_uCount)
+		{
+			if (!std::is_pointer<T>::value)
+				return;
+
+			void** m_pSlots = reinterpret_cast<void**>(data() + m_uIndex);
+			for (uintptr_t u = 0; m_uCount > u; ++u)
+				il2cpp_gc_wbarrier_set_field((Il2CppObject*) this, &m_pSlots[u], m_pSlots[u]);
+		}
+
 		void Insert(T* m_pArray, uintptr_t m_uSize, uintptr_t m_uIndex = 0)
 		{
 			if ((m_uSize + m_uIndex) >= m_uMaxLength)
@@ -34,28 +57,25 @@ namespace Unity
 				m_uSize = m_uMaxLength - m_uIndex;
 			}
 
-			for (uintptr_t u = 0; m_uSize > u; ++u)
-				operator[](u + m_uIndex) = m_pArray[u];
+			memmove(data() + m_uIndex, m_pArray, sizeof(T) * m_uSize);
+			WriteBarrier(m_uIndex, m_uSize);
 		}
 
 		void Fill(T m_tValue)
 		{
-			for (uintptr_t u = 0; m_uMaxLength > u; ++u)
-				operator[](u) = m_tValue;
+			static const T m_tZero = {};
+			if (memcmp(&m_tValue, &m_tZero, sizeof(T)) == 0)
+				memset(data(), 0, sizeof(T) * m_uMaxLength);
+			else
+			{
+				std::fill_n(data(), m_uMaxLength, m_tValue);
+				WriteBarrier(0, m_uMaxLength);
+			}
 		}
 
 		void RemoveAt(unsigned int m_uIndex)
 		{
-			if (m_uIndex >= m_uMaxLength)
-				return;
-
-			if (m_uMaxLength > (m_uIndex + 1))
-			{
-				for (unsigned int u = m_uIndex; (static_cast<unsigned int>(m_uMaxLength) - m_uIndex) > u; ++u)
-					operator[](u) = operator[](u + 1);
-			}
-
-			--m_uMaxLength;
+			RemoveRange(m_uIndex, 1);
 		}
 
 		void RemoveRange(unsigned int m_uIndex, unsigned int m_uCount)
@@ -63,15 +83,13 @@ namespace Unity
 			if (m_uCount == 0)
 				m_uCount = 1;
 
-			unsigned int m_uTotal = m_uIndex + m_uCount;
-			if (m_uTotal >= m_uMaxLength)
+			uintptr_t m_uTotal = static_cast<uintptr_t>(m_uIndex) + m_uCount;
+			if (m_uTotal > m_uMaxLength)
 				return;
 
-			if (m_uMaxLength > (m_uTotal + 1))
-			{
-				for (unsigned int u = m_uIndex; (static_cast<unsigned int>(m_uMaxLength) - m_uTotal) >= u; ++u)
-					operator[](u) = operator[](u + m_uCount);
-			}
+			uintptr_t m_uTail = m_uMaxLength - m_uTotal;
+			memmove(data() + m_uIndex, data() + m_uTotal, sizeof(T) * m_uTail);
+			WriteBarrier(m_uIndex, m_uTail);
 
 			m_uMaxLength -= m_uCount;
 		}
@@ -91,7 +109,22 @@ namespace Unity
 	struct il2cppList : il2cppObject
 	{
 		il2cppArray<T>* m_pListArray;
+		int m_iSize;
+		int m_iVersion;
 
 		il2cppArray<T>* ToArray() { return m_pListArray; }
+
+		// Only the first m_iSize elements of the backing array are in the list.
+		T* data() { return m_pListArray ? m_pListArray->data() : nullptr; }
+		T* begin() { return data(); }
+		T* end() { return data() + size(); }
+		size_t size() const { return m_pListArray ? static_cast<size_t>((std::min)(static_cast<uintptr_t>(m_iSize), m_pListArray->m_uMaxLength)) : 0U; }
+
+		T& operator[](unsigned int m_uIndex) { return data()[m_uIndex]; }
+
+#if __cplusplus >= 202002L
+		std::span<T> AsSpan() { return std::span<T>(data(), size()); }
+		operator std::span<T>() { return AsSpan(); }
+#endif
 	};
 }
\ No newline at end of file
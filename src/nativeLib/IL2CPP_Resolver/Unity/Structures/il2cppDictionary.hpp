@@ -2,6 +2,59 @@
 
 namespace Unity
 {
+	// .NET GetHashCode of a dictionary key. m_bHashed is false when no hash is known, lookups then scan
+	// the entries; m_bExact is false when the dictionary may use another comparer, a miss on the
+	// bucket chain then falls back to a scan.
+	template<typename T, typename Enable = void>
+	struct il2cppKeyHasher
+	{
+		static constexpr bool m_bHashed = false;
+		static constexpr bool m_bExact = false;
+
+		static int Get(const T&) { return 0; }
+		static bool Equals(const T& m_tLeft, const T& m_tRight) { return m_tLeft == m_tRight; }
+	};
+
+	template<typename T>
+	struct il2cppKeyHasher<T, typename std::enable_if<std::is_integral<T>::value>::type>
+	{
+		static constexpr bool m_bHashed = true;
+		static constexpr bool m_bExact = true;
+
+		// Mirrors Boolean/SByte/Int16/Char/Int32/Int64 (and unsigned) GetHashCode; UInt16 hashes to its value.
+		static int Get(const T& m_tKey)
+		{
+			if (std::is_same<T, bool>::value)
+				return m_tKey ? 1 : 0;
+
+			if (sizeof(T) == 1 && std::is_signed<T>::value)
+				return static_cast<int>(m_tKey) ^ (static_cast<int>(m_tKey) << 8);
+
+			if (sizeof(T) == 2 && (std::is_signed<T>::value || std::is_same<T, char16_t>::value))
+				return static_cast<int>(static_cast<uint16_t>(m_tKey) | (static_cast<uint32_t>(static_cast<int>(m_tKey)) << 16));
+
+			if (sizeof(T) == 8)
+				return static_cast<int>(static_cast<uint64_t>(m_tKey)) ^ static_cast<int>(static_cast<uint64_t>(m_tKey) >> 32);
+
+			return static_cast<int>(m_tKey);
+		}
+
+		static bool Equals(const T& m_tLeft, const T& m_tRight) { return m_tLeft == m_tRight; }
+	};
+
+	// Enums hash as their underlying type.
+	template<typename T>
+	struct il2cppKeyHasher<T, typename std::enable_if<std::is_enum<T>::value>::type>
+	{
+		using Underlying_t = typename std::underlying_type<T>::type;
+
+		static constexpr bool m_bHashed = true;
+		static constexpr bool m_bExact = true;
+
+		static int Get(const T& m_tKey) { return il2cppKeyHasher<Underlying_t>::Get(static_cast<Underlying_t>(m_tKey)); }
+		static bool Equals(const T& m_tLeft, const T& m_tRight) { return m_tLeft == m_tRight; }
+	};
+
 	template<typename TKey,typename TValue>
 	struct il2cppDictionary : il2cppObject
 	{
@@ -49,14 +102,112 @@ namespace Unity
 			return tValue;
 		}
 
+		// Free-list slots: old BCL marks them with hashCode -1, corefx with next below -1.
+		static bool IsFree(const Entry& m_Entry)
+		{
+			return m_Entry.m_iNext < -1 || m_Entry.m_iHashCode == -1;
+		}
+
+		// Index into the entries, or -1. Follows the buckets/next chains the way .NET does; both the
+		// 0-based (BCL) and 1-based (corefx) bucket encodings are tried, matches are verified on
+		// hash and key so a wrong guess can only miss.
+		template<typename THasher = il2cppKeyHasher<TKey>>
+		int FindIndex(const TKey& m_tKey)
+		{
+			if (!m_pEntries)
+				return -1;
+
+			Entry* m_pEntry = GetEntry();
+			int m_iCapacity = static_cast<int>(m_pEntries->m_uMaxLength);
+			if (THasher::m_bHashed && m_pBuckets && m_pBuckets->m_uMaxLength)
+			{
+				int m_iRaw = THasher::Get(m_tKey);
+				int m_iMasked = m_iRaw & 0x7FFFFFFF;
+				uint32_t m_uBuckets = static_cast<uint32_t>(m_pBuckets->m_uMaxLength);
+				uint32_t m_uIndices[2] = { static_cast<uint32_t>(m_iMasked) % m_uBuckets, static_cast<uint32_t>(m_iRaw) % m_uBuckets };
+
+				for (int b = 0; (m_uIndices[0] == m_uIndices[1] ? 1 : 2) > b; ++b)
+				{
+					int m_iBucket = m_pBuckets->operator[](m_uIndices[b]);
+					for (int m_iStart : { m_iBucket - 1, m_iBucket })
+					{
+						int m_iSteps = 0;
+						for (int i = m_iStart; i >= 0 && m_iCapacity > i && m_iCount >= m_iSteps; i = m_pEntry[i].m_iNext, ++m_iSteps)
+						{
+							if ((m_pEntry[i].m_iHashCode == m_iMasked || m_pEntry[i].m_iHashCode == m_iRaw) && THasher::Equals(m_pEntry[i].m_tKey, m_tKey))
+								return i;
+						}
+					}
+				}
+
+				if (THasher::m_bExact)
+					return -1;
+			}
+
+			for (int i = 0; m_iCount > i && m_iCapacity > i; ++i)
+			{
+				if (!IsFree(m_pEntry[i]) && THasher::Equals(m_pEntry[i].m_tKey, m_tKey))
+					return i;
+			}
+
+			return -1;
+		}
+
+		template<typename THasher = il2cppKeyHasher<TKey>>
+		bool TryGetValue(const TKey& m_tKey, TValue* m_pValue)
+		{
+			int m_iIndex = FindIndex<THasher>(m_tKey);
+			if (0 > m_iIndex)
+				return false;
+
+			*m_pValue = GetEntry()[m_iIndex].m_tValue;
+			return true;
+		}
+
+		bool ContainsKey(const TKey& m_tKey)
+		{
+			return FindIndex(m_tKey) >= 0;
+		}
+
 		TValue GetValueByKey(TKey tKey)
 		{
 			TValue tValue = { 0 };
-			for (int i = 0; i < m_iCount; i++) {
-				if (GetEntry()[i].m_tKey == tKey)
-					tValue =  GetEntry()[i].m_tValue;
-			}
+			TryGetValue(tKey, &tValue);
 			return tValue;
 		}
+
+		// Iterates the used entries, skipping free-list slots.
+		struct Iterator
+		{
+			Entry* m_pEntry;
+			int m_iIndex;
+			int m_iEnd;
+
+			void Skip()
+			{
+				while (m_iEnd > m_iIndex && IsFree(m_pEntry[m_iIndex]))
+					++m_iIndex;
+			}
+
+			Entry& operator*() const { return m_pEntry[m_iIndex]; }
+			Entry* operator->() const { return &m_pEntry[m_iIndex]; }
+			Iterator& operator++() { ++m_iIndex; Skip(); return *this; }
+			bool operator==(const Iterator& m_Other) const { return m_iIndex == m_Other.m_iIndex; }
+			bool operator!=(const Iterator& m_Other) const { return m_iIndex != m_Other.m_iIndex; }
+		};
+
+		Iterator begin()
+		{
+			int m_iEnd = m_pEntries ? (std::min)(m_iCount, static_cast<int>(m_pEntries->m_uMaxLength)) : 0;
+			Iterator m_It = { m_pEntries ? GetEntry() : nullptr, 0, m_iEnd };
+			m_It.Skip();
+			return m_It;
+		}
+
+		Iterator end()
+		{
+			int m_iEnd = m_pEntries ? (std::min)(m_iCount, static_cast<int>(m_pEntries->m_uMaxLength)) : 0;
+			return { nullptr, m_iEnd, m_iEnd };
+		}
 	};
 }
@@ -0,0 +1,190 @@
+#pragma once
+
+namespace IL2CPP
+{
+	namespace Utils
+	{
+		// Insert-only open addressing table for the resolver caches.
+		//
+		// Entries are identified by (m_uKey, m_uHash) and, when both sides have one, the full name,
+		// so a hash collision between two names never returns the wrong entry. Slots are claimed
+		// with a CAS and published with a release store; readers never wait and never write, a
+		// lookup is a bounded probe over each table. When a table is half full a table of twice
+		// the size is chained behind it, older tables stay valid so no entry ever moves.
+		//
+		// Entries are never removed. Two threads inserting the same key at the same time may both
+		// succeed, lookups then return whichever one is found first.
+		template<typename T>
+		class CFlatHashMap
+		{
+		public:
+			explicit CFlatHashMap(size_t m_uCapacity = 1024)
+			{
+				size_t m_uSize = 16;
+				while (m_uSize < m_uCapacity) m_uSize <<= 1;
+				m_pFirst = new Table_t(m_uSize);
+			}
+
+			CFlatHashMap(const CFlatHashMap&) = delete;
+			CFlatHashMap& operator=(const CFlatHashMap&) = delete;
+
+			~CFlatHashMap()
+			{
+				for (Table_t* m_pTable = m_pFirst; m_pTable;)
+				{
+					Table_t* m_pNext = m_pTable->m_pNext.load(std::memory_order_relaxed);
+					delete m_pTable;
+					m_pTable = m_pNext;
+				}
+			}
+
+			// m_pName may be nullptr to match on (key, hash) alone.
+			T* Find(uint64_t m_uKey, uint32_t m_uHash, const char* m_pName = nullptr) const
+			{
+				for (Table_t* m_pTable = m_pFirst; m_pTable; m_pTable = m_pTable->m_pNext.load(std::memory_order_acquire))
+				{
+					size_t i = Mix(m_uKey, m_uHash) & m_pTable->m_uMask;
+					for (size_t m_uProbe = 0; m_pTable->m_uMask >= m_uProbe; ++m_uProbe, i = (i + 1) & m_pTable->m_uMask)
+					{
+						Slot_t& m_Slot = m_pTable->m_pSlots[i];
+						uint32_t m_uState = m_Slot.m_uState.load(std::memory_order_acquire);
+						if (m_uState == m_eEmpty)
+							break;
+
+						if (m_uState == m_eReady && Matches(m_Slot, m_uKey, m_uHash, m_pName))
+							return &m_Slot.m_Value;
+					}
+				}
+
+				return nullptr;
+			}
+
+			// Returns the existing entry, or a new one after m_fInit(T&) filled it in.
+			template<typename F>
+			T* Insert(uint64_t m_uKey, uint32_t m_uHash, const char* m_pName, F m_fInit)
+			{
+				if (T* m_pExisting = Find(m_uKey, m_uHash, m_pName))
+					return m_pExisting;
+
+				Table_t* m_pTable = m_pFirst;
+				while (1)
+				{
+					Table_t* m_pNext = m_pTable->m_pNext.load(std::memory_order_acquire);
+					if (m_pNext)
+					{
+						m_pTable = m_pNext;
+						continue;
+					}
+
+					if (m_pTable->m_uUsed.load(std::memory_order_relaxed) * 2 >= m_pTable->m_uMask + 1)
+					{
+						Table_t* m_pGrown = new Table_t((m_pTable->m_uMask + 1) * 2);
+						if (!m_pTable->m_pNext.compare_exchange_strong(m_pNext, m_pGrown, std::memory_order_acq_rel))
+							delete m_pGrown;
+						continue;
+					}
+
+					size_t i = Mix(m_uKey, m_uHash) & m_pTable->m_uMask;
+					for (size_t m_uProbe = 0; m_pTable->m_uMask >= m_uProbe; ++m_uProbe, i = (i + 1) & m_pTable->m_uMask)
+					{
+						Slot_t& m_Slot = m_pTable->m_pSlots[i];
+						uint32_t m_uState = m_Slot.m_uState.load(std::memory_order_acquire);
+						if (m_uState == m_eReady && Matches(m_Slot, m_uKey, m_uHash, m_pName))
+							return &m_Slot.m_Value;
+
+						if (m_uState != m_eEmpty || !m_Slot.m_uState.compare_exchange_strong(m_uState, m_eWriting, std::memory_order_acquire))
+							continue;
+
+						m_Slot.m_uKey = m_uKey;
+						m_Slot.m_uHash = m_uHash;
+						m_Slot.m_pName = m_pName ? strdup(m_pName) : nullptr;
+						m_fInit(m_Slot.m_Value);
+						m_Slot.m_uState.store(m_eReady, std::memory_order_release);
+						m_pTable->m_uUsed.fetch_add(1, std::memory_order_relaxed);
+						return &m_Slot.m_Value;
+					}
+
+					// Lost every race in this table, it is full now.
+					m_pTable->m_uUsed.store(m_pTable->m_uMask + 1, std::memory_order_relaxed);
+				}
+			}
+
+			// Visits published entries; safe alongside readers and writers.
+			template<typename F>
+			void ForEach(F m_fVisit)
+			{
+				for (Table_t* m_pTable = m_pFirst; m_pTable; m_pTable = m_pTable->m_pNext.load(std::memory_order_acquire))
+				{
+					for (size_t i = 0; m_pTable->m_uMask >= i; ++i)
+					{
+						if (m_pTable->m_pSlots[i].m_uState.load(std::memory_order_acquire) == m_eReady)
+							m_fVisit(m_pTable->m_pSlots[i].m_Value);
+					}
+				}
+			}
+
+			size_t Size() const
+			{
+				size_t m_uSize = 0;
+				for (Table_t* m_pTable = m_pFirst; m_pTable; m_pTable = m_pTable->m_pNext.load(std::memory_order_acquire))
+					m_uSize += (std::min)(m_pTable->m_uUsed.load(std::memory_order_relaxed), m_pTable->m_uMask + 1);
+
+				return m_uSize;
+			}
+
+		private:
+			enum : uint32_t
+			{
+				m_eEmpty = 0,
+				m_eWriting,
+				m_eReady,
+			};
+
+			struct Slot_t
+			{
+				std::atomic<uint32_t> m_uState = { m_eEmpty };
+				uint32_t m_uHash = 0;
+				uint64_t m_uKey = 0;
+				char* m_pName = nullptr;
+				T m_Value = {};
+			};
+
+			struct Table_t
+			{
+				size_t m_uMask;
+				std::atomic<size_t> m_uUsed = { 0 };
+				std::atomic<Table_t*> m_pNext = { nullptr };
+				Slot_t* m_pSlots;
+
+				explicit Table_t(size_t m_uSize) : m_uMask(m_uSize - 1), m_pSlots(new Slot_t[m_uSize]) {}
+
+				~Table_t()
+				{
+					for (size_t i = 0; m_uMask >= i; ++i)
+						free(m_pSlots[i].m_pName);
+
+					delete[] m_pSlots;
+				}
+			};
+
+			static size_t Mix(uint64_t m_uKey, uint32_t m_uHash)
+			{
+				uint64_t m_uMixed = (m_uKey ^ (static_cast<uint64_t>(m_uHash) * 0x9E3779B97F4A7C15ull));
+				m_uMixed ^= m_uMixed >> 29;
+				m_uMixed *= 0xBF58476D1CE4E5B9ull;
+				m_uMixed ^= m_uMixed >> 32;
+				return static_cast<size_t>(m_uMixed);
+			}
+
+			static bool Matches(const Slot_t& m_Slot, uint64_t m_uKey, uint32_t m_uHash, const char* m_pName)
+			{
+				if (m_Slot.m_uKey != m_uKey || m_Slot.m_uHash != m_uHash)
+					return false;
+
+				return !m_pName || !m_Slot.m_pName || strcmp(m_Slot.m_pName, m_pName) == 0;
+			}
+
+			Table_t* m_pFirst;
+		};
+	}
+}
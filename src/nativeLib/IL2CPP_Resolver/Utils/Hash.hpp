@@ -50,3 +50,6 @@ namespace IL2CPP
     static constexpr uint32_t m_Hash = IL2CPP::Utils::Hash::GetCompileTime(m_String); \
     return m_Hash; \
 }()
+
+// Class lookup with the name hashed at compile time, e.g. IL2CPP_FIND_CLASS("UnityEngine.GameObject")
+#define IL2CPP_FIND_CLASS(m_String) IL2CPP::Class::Find(m_String, IL2CPP_HASH(m_String))
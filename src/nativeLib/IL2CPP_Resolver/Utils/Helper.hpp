@@ -19,5 +19,187 @@ namespace IL2CPP
 
 			return nullptr;
 		}
+
+		// Appends UTF-16 as UTF-8 without a temporary string; unpaired surrogates become U+FFFD.
+		void AppendUTF8(std::string* m_pOut, const char16_t* m_pString, int m_iLength)
+		{
+			for (int i = 0; m_iLength > i; ++i)
+			{
+				uint32_t m_uCode = m_pString[i];
+				if (m_uCode >= 0xD800U && m_uCode <= 0xDBFFU && m_iLength > i + 1 && m_pString[i + 1] >= 0xDC00U && m_pString[i + 1] <= 0xDFFFU)
+					m_uCode = 0x10000U + ((m_uCode - 0xD800U) << 10) + (m_pString[++i] - 0xDC00U);
+				else if (m_uCode >= 0xD800U && m_uCode <= 0xDFFFU)
+					m_uCode = 0xFFFDU;
+
+				if (m_uCode < 0x80U)
+					m_pOut->push_back(static_cast<char>(m_uCode));
+				else if (m_uCode < 0x800U)
+				{
+					m_pOut->push_back(static_cast<char>(0xC0U | (m_uCode >> 6)));
+					m_pOut->push_back(static_cast<char>(0x80U | (m_uCode & 0x3FU)));
+				}
+				else if (m_uCode < 0x10000U)
+				{
+					m_pOut->push_back(static_cast<char>(0xE0U | (m_uCode >> 12)));
+					m_pOut->push_back(static_cast<char>(0x80U | ((m_uCode >> 6) & 0x3FU)));
+					m_pOut->push_back(static_cast<char>(0x80U | (m_uCode & 0x3FU)));
+				}
+				else
+				{
+					m_pOut->push_back(static_cast<char>(0xF0U | (m_uCode >> 18)));
+					m_pOut->push_back(static_cast<char>(0x80U | ((m_uCode >> 12) & 0x3FU)));
+					m_pOut->push_back(static_cast<char>(0x80U | ((m_uCode >> 6) & 0x3FU)));
+					m_pOut->push_back(static_cast<char>(0x80U | (m_uCode & 0x3FU)));
+				}
+			}
+		}
+
+		struct ComponentRecord_t
+		{
+			Unity::CComponent* m_pComponent;
+			Unity::il2cppClass* m_pClass;
+		};
+
+		// Only valid inside the callback, the name and component storage is reused for the next object.
+		struct GameObjectRecord_t
+		{
+			Unity::CGameObject* m_pObject;
+			Unity::il2cppClass* m_pClass;
+			const char* m_pName;
+			size_t m_sNameLength;
+			const ComponentRecord_t* m_pComponents;
+			size_t m_sComponents;
+		};
+
+		// Streams every GameObject to m_fRecord(const GameObjectRecord_t&). The object and component
+		// System.Types are resolved once per call instead of once per object, and names are converted
+		// into one buffer. Component.name is the name of its GameObject, so components carry no name.
+		// Returns the number of records, or 0 if the types could not be resolved.
+		template<typename F>
+		size_t EnumerateGameObjects(F m_fRecord, bool m_bIncludeInactive = false)
+		{
+			Unity::il2cppObject* m_pObjectType = SystemTypeCache::Get(UNITY_GAMEOBJECT_CLASS);
+			if (!m_pObjectType) m_pObjectType = Class::GetSystemType(UNITY_GAMEOBJECT_CLASS);
+
+			Unity::il2cppObject* m_pComponentType = SystemTypeCache::Get(UNITY_COMPONENT_CLASS);
+			if (!m_pComponentType) m_pComponentType = Class::GetSystemType(UNITY_COMPONENT_CLASS);
+
+			if (!m_pObjectType || !m_pComponentType)
+				return 0U;
+
+			Unity::il2cppArray<Unity::CGameObject*>* m_pObjects = Unity::Object::FindObjectsOfType<Unity::CGameObject>(m_pObjectType, m_bIncludeInactive);
+			if (!m_pObjects)
+				return 0U;
+
+			std::string m_sName;
+			std::vector<ComponentRecord_t> m_vComponents;
+			m_sName.reserve(256U);
+			m_vComponents.reserve(32U);
+
+			size_t m_sRecords = 0U;
+			for (Unity::CGameObject* m_pObject : *m_pObjects)
+			{
+				if (!m_pObject) continue;
+
+				m_sName.clear();
+				if (Unity::System_String* m_pName = m_pObject->GetName())
+					AppendUTF8(&m_sName, m_pName->m_wString, m_pName->m_iLength);
+
+				m_vComponents.clear();
+				if (Unity::il2cppArray<Unity::CComponent*>* m_pComponents = m_pObject->GetComponents(m_pComponentType))
+				{
+					for (Unity::CComponent* m_pComponent : *m_pComponents)
+					{
+						if (m_pComponent)
+							m_vComponents.push_back({ m_pComponent, m_pComponent->m_Object.m_pClass });
+					}
+				}
+
+				m_fRecord(GameObjectRecord_t{ m_pObject, m_pObject->m_Object.m_pClass, m_sName.c_str(), m_sName.size(), m_vComponents.data(), m_vComponents.size() });
+				++m_sRecords;
+			}
+
+			return m_sRecords;
+		}
+
+		// Binary sink for EnumerateGameObjects, buffered and written to a FILE* in 64 KiB blocks.
+		//
+		// Header: "GOBJ", u32 version. Per object, little endian:
+		//	u64 object, u16 name length, name, u16 class name length, class name, u32 component count,
+		//	then per component: u64 component, u16 class name length, class name.
+		class CGameObjectWriter
+		{
+		public:
+			static constexpr uint32_t m_uVersion = 1U;
+
+			explicit CGameObjectWriter(FILE* m_pFile) : m_pFile(m_pFile)
+			{
+				m_vBuffer.reserve(m_sBlockSize);
+				m_vBuffer.insert(m_vBuffer.end(), { 'G', 'O', 'B', 'J' });
+				Put(m_uVersion);
+			}
+
+			CGameObjectWriter(const CGameObjectWriter&) = delete;
+			CGameObjectWriter& operator=(const CGameObjectWriter&) = delete;
+
+			~CGameObjectWriter()
+			{
+				Flush();
+			}
+
+			void operator()(const GameObjectRecord_t& m_Record)
+			{
+				Put(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(m_Record.m_pObject)));
+				PutString(m_Record.m_pName, m_Record.m_sNameLength);
+				PutString(m_Record.m_pClass ? m_Record.m_pClass->m_pName : nullptr);
+				Put(static_cast<uint32_t>(m_Record.m_sComponents));
+
+				for (size_t i = 0U; m_Record.m_sComponents > i; ++i)
+				{
+					Put(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(m_Record.m_pComponents[i].m_pComponent)));
+					PutString(m_Record.m_pComponents[i].m_pClass ? m_Record.m_pComponents[i].m_pClass->m_pName : nullptr);
+				}
+
+				if (m_vBuffer.size() >= m_sBlockSize)
+					Flush();
+			}
+
+			// Returns false once any write has failed.
+			bool Flush()
+			{
+				if (!m_vBuffer.empty() && m_pFile && fwrite(m_vBuffer.data(), 1U, m_vBuffer.size(), m_pFile) != m_vBuffer.size())
+					m_bFailed = true;
+
+				m_vBuffer.clear();
+				return !m_bFailed;
+			}
+
+		private:
+			static constexpr size_t m_sBlockSize = 64U * 1024U;
+
+			template<typename T>
+			void Put(T m_Value)
+			{
+				char m_Bytes[sizeof(T)];
+				for (size_t i = 0U; sizeof(T) > i; ++i)
+					m_Bytes[i] = static_cast<char>((m_Value >> (i * 8U)) & 0xFFU);
+
+				m_vBuffer.insert(m_vBuffer.end(), m_Bytes, m_Bytes + sizeof(T));
+			}
+
+			void PutString(const char* m_pString, size_t m_sLength = SIZE_MAX)
+			{
+				if (!m_pString) m_sLength = 0U;
+				else if (m_sLength == SIZE_MAX) m_sLength = strlen(m_pString);
+
+				m_sLength = (std::min)(m_sLength, static_cast<size_t>(UINT16_MAX));
+				Put(static_cast<uint16_t>(m_sLength));
+				m_vBuffer.insert(m_vBuffer.end(), m_pString, m_pString + m_sLength);
+			}
+
+			FILE* m_pFile;
+			std::vector<char> m_vBuffer;
+			bool m_bFailed = false;
+		};
 	}
-}
\ No newline at end of file
+}
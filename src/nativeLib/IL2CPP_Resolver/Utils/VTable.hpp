@@ -6,22 +6,224 @@ namespace IL2CPP
     {
         namespace VTable
         {
-            void ReplaceFunction(void** m_VTableFunc, void* m_NewFunc, void** m_Original = nullptr)
+            // Protection of every mapping, read once per batch from /proc/self/maps.
+            struct Mapping_t
+            {
+                uintptr_t m_uStart;
+                uintptr_t m_uEnd;
+                int m_iProtection;
+            };
+
+            void ReadMappings(std::vector<Mapping_t>* m_pMappings)
             {
-                if (!m_VTableFunc)
+                m_pMappings->clear();
+
+                FILE* m_pFile = fopen("/proc/self/maps", "re");
+                if (!m_pFile)
                     return;
 
-                // TODO:
+                char m_szLine[512];
+                while (fgets(m_szLine, sizeof(m_szLine), m_pFile))
+                {
+                    unsigned long m_uStart = 0U, m_uEnd = 0U;
+                    char m_szPerms[5] = { 0 };
+                    if (sscanf(m_szLine, "%lx-%lx %4s", &m_uStart, &m_uEnd, m_szPerms) != 3)
+                        continue;
+
+                    int m_iProtection = PROT_NONE;
+                    if (m_szPerms[0] == 'r') m_iProtection |= PROT_READ;
+                    if (m_szPerms[1] == 'w') m_iProtection |= PROT_WRITE;
+                    if (m_szPerms[2] == 'x') m_iProtection |= PROT_EXEC;
+                    m_pMappings->push_back({ static_cast<uintptr_t>(m_uStart), static_cast<uintptr_t>(m_uEnd), m_iProtection });
+                }
+
+                fclose(m_pFile);
+            }
+
+            // -1 if the address is not mapped. m_Mappings is sorted, as the kernel lists it.
+            int GetProtection(const std::vector<Mapping_t>& m_Mappings, uintptr_t m_uAddress)
+            {
+                auto m_It = std::upper_bound(m_Mappings.begin(), m_Mappings.end(), m_uAddress, [](uintptr_t m_uValue, const Mapping_t& m_Mapping) { return m_uValue < m_Mapping.m_uStart; });
+                if (m_It == m_Mappings.begin() || m_uAddress >= (--m_It)->m_uEnd)
+                    return -1;
+
+                return m_It->m_iProtection;
+            }
+
+            // Slot replacements applied together: slots are grouped by page and each page is made
+            // writable once, patched, and put back to the protection it had. Originals are kept so
+            // Restore() can put every slot back the same way.
+            class CPatchBatch
+            {
+            public:
+                void Add(void** m_VTableFunc, void* m_NewFunc, void** m_Original = nullptr)
+                {
+                    if (m_VTableFunc)
+                        m_vPatches.push_back({ m_VTableFunc, m_NewFunc, nullptr, m_Original, false });
+                }
+
+                // Returns false if a page could not be made writable; slots on other pages are still patched.
+                bool Commit()
+                {
+                    return Apply(false);
+                }
+
+                bool Restore()
+                {
+                    return Apply(true);
+                }
+
+                size_t GetSize() const { return m_vPatches.size(); }
+
+                size_t GetProtectCalls() const { return m_sProtectCalls; }
+
+            private:
+                struct Patch_t
+                {
+                    void** m_pSlot;
+                    void* m_pNew;
+                    void* m_pOriginal;
+                    void** m_pOriginalOut;
+                    bool m_bApplied;    // written by Commit(), so Restore() has an original for it
+                };
+
+                bool Apply(bool m_bRestore)
+                {
+                    if (m_vPatches.empty() || m_bCommitted != m_bRestore)
+                        return false;
+
+                    std::vector<Mapping_t> m_Mappings;
+                    ReadMappings(&m_Mappings);
+
+                    uintptr_t m_uPageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+                    auto m_Page = [m_uPageSize](const Patch_t& m_Patch) { return reinterpret_cast<uintptr_t>(m_Patch.m_pSlot) & ~(m_uPageSize - 1); };
+                    std::stable_sort(m_vPatches.begin(), m_vPatches.end(), [&m_Page](const Patch_t& m_Left, const Patch_t& m_Right) { return m_Page(m_Left) < m_Page(m_Right); });
+
+                    bool m_bSuccess = true;
+                    for (size_t i = 0U; m_vPatches.size() > i;)
+                    {
+                        uintptr_t m_uPage = m_Page(m_vPatches[i]);
+                        size_t m_sEnd = i;
+                        bool m_bAnyApplied = false;
+                        while (m_vPatches.size() > m_sEnd && m_Page(m_vPatches[m_sEnd]) == m_uPage)
+                            m_bAnyApplied |= m_vPatches[m_sEnd++].m_bApplied;
+
+                        // Nothing to put back on a page Commit() could not write.
+                        if (m_bRestore && !m_bAnyApplied)
+                        {
+                            i = m_sEnd;
+                            continue;
+                        }
+
+                        int m_iProtection = GetProtection(m_Mappings, m_uPage);
+                        bool m_bWritable = m_iProtection >= 0 && (m_iProtection & PROT_WRITE);
+                        if (!m_bWritable)
+                        {
+                            ++m_sProtectCalls;
+                            if (m_iProtection < 0 || mprotect(reinterpret_cast<void*>(m_uPage), m_uPageSize, m_iProtection | PROT_READ | PROT_WRITE) != 0)
+                            {
+                                m_bSuccess = false;
+                                i = m_sEnd;
+                                continue;
+                            }
+                        }
+
+                        if (m_bRestore)
+                        {
+                            // Reverse order, so a slot added twice ends up with the value it had before the first patch.
+                            for (size_t j = m_sEnd; j > i; --j)
+                            {
+                                Patch_t& m_Patch = m_vPatches[j - 1U];
+                                if (!m_Patch.m_bApplied)
+                                    continue;
+
+                                __atomic_store_n(m_Patch.m_pSlot, m_Patch.m_pOriginal, __ATOMIC_RELEASE);
+                                m_Patch.m_bApplied = false;
+                            }
+                        }
+                        else
+                        {
+                            for (size_t j = i; m_sEnd > j; ++j)
+                            {
+                                Patch_t& m_Patch = m_vPatches[j];
+
+                                // The new function may run as soon as the slot changes, so its original is published first.
+                                void* m_pExpected = __atomic_load_n(m_Patch.m_pSlot, __ATOMIC_ACQUIRE);
+                                if (m_Patch.m_pOriginalOut)
+                                    __atomic_store_n(m_Patch.m_pOriginalOut, m_pExpected, __ATOMIC_RELEASE);
+
+                                m_Patch.m_pOriginal = __atomic_exchange_n(m_Patch.m_pSlot, m_Patch.m_pNew, __ATOMIC_ACQ_REL);
+                                m_Patch.m_bApplied = true;
+                                if (m_Patch.m_pOriginalOut && m_Patch.m_pOriginal != m_pExpected)
+                                    __atomic_store_n(m_Patch.m_pOriginalOut, m_Patch.m_pOriginal, __ATOMIC_RELEASE);
+                            }
+                        }
+                        i = m_sEnd;
+
+                        if (!m_bWritable)
+                        {
+                            ++m_sProtectCalls;
+                            mprotect(reinterpret_cast<void*>(m_uPage), m_uPageSize, m_iProtection);
+                        }
+                    }
+
+                    m_bCommitted = !m_bRestore;
+                    return m_bSuccess;
+                }
+
+                std::vector<Patch_t> m_vPatches;
+                size_t m_sProtectCalls = 0U;
+                bool m_bCommitted = false;
+            };
 
-                // DWORD m_OldProtection = 0x0;
-                // if (!VirtualProtect(m_VTableFunc, sizeof(void*), PAGE_READWRITE, &m_OldProtection))
-                //     return;
-             
-                // if (m_Original) 
-                //     *m_Original = *m_VTableFunc;
+            void ReplaceFunction(void** m_VTableFunc, void* m_NewFunc, void** m_Original = nullptr)
+            {
+                CPatchBatch m_Batch;
+                m_Batch.Add(m_VTableFunc, m_NewFunc, m_Original);
+                m_Batch.Commit();
+            }
+
+            struct Search_t
+            {
+                void** m_VTable;
+                int m_Count;
+            };
+
+            // Finds the first slot whose code starts with each signature, searching every vtable in
+            // one pass; slots are only compared against signatures that share their first byte.
+            // m_pResults gets one entry per signature, nullptr when nothing matched.
+            void FindFunctions(std::initializer_list<Search_t> m_vVTables, std::initializer_list<std::initializer_list<unsigned char>> m_vSignatures, std::vector<void**>* m_pResults)
+            {
+                const std::initializer_list<unsigned char>* m_pSignatures = m_vSignatures.begin();
+                size_t m_sSignatures = m_vSignatures.size();
+                m_pResults->assign(m_sSignatures, nullptr);
 
-                // *m_VTableFunc = m_NewFunc;
-                // VirtualProtect(m_VTableFunc, sizeof(void*), m_OldProtection, &m_OldProtection);
+                std::vector<size_t> m_vByFirstByte[256];
+                for (size_t s = 0U; m_sSignatures > s; ++s)
+                {
+                    if (m_pSignatures[s].size())
+                        m_vByFirstByte[*m_pSignatures[s].begin()].push_back(s);
+                }
+
+                size_t m_sPending = m_sSignatures;
+                for (const Search_t& m_Search : m_vVTables)
+                {
+                    for (int i = 0; m_Search.m_Count > i && m_sPending; ++i)
+                    {
+                        const unsigned char* m_pCode = reinterpret_cast<const unsigned char*>(m_Search.m_VTable[i]);
+                        if (!m_pCode)
+                            continue;
+
+                        for (size_t s : m_vByFirstByte[*m_pCode])
+                        {
+                            if (m_pResults->operator[](s) || memcmp(m_pCode, m_pSignatures[s].begin(), m_pSignatures[s].size()) != 0)
+                                continue;
+
+                            m_pResults->operator[](s) = &m_Search.m_VTable[i];
+                            --m_sPending;
+                        }
+                    }
+                }
             }
 
             void** FindFunction(void** m_VTable, int m_Count, std::initializer_list<unsigned char> m_Opcodes)
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+/**
+ * \brief timings of injection startup, shared by IL2CPP::Initialize and UnityResolve::Init
+ *
+ * A phase is a scope without an item name ("IL2CPP::Manifest"), an item is one thing resolved
+ * inside a phase ("UnityEngine.Camera::get_main"). Scopes nest; each one records a single entry
+ * when it closes. The profiler starts disabled, where a scope costs one relaxed load; call
+ * SetEnabled(true) before IL2CPP::Initialize / UnityResolve::Init to collect. Entries are kept
+ * until Clear(), so turn it off again once reported. Reports are text, JSON, or Chrome trace
+ * events (chrome://tracing, Perfetto).
+ */
+class StartupProfiler final {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Entry {
+		std::string   phase;
+		std::string   item;      // empty for the phase scope itself
+		std::uint64_t startNs;   // since the profiler was created
+		std::uint64_t durationNs;
+		std::uint32_t tid;
+		std::uint32_t depth;     // nesting on the recording thread
+	};
+
+	struct PhaseTotal {
+		std::string   phase;
+		std::uint64_t totalNs;   // phase scopes, or the items when the phase has no scope
+		std::uint64_t itemNs;
+		size_t        items;
+	};
+
+	static auto Instance() -> StartupProfiler& {
+		static StartupProfiler profiler;
+		return profiler;
+	}
+
+	auto SetEnabled(const bool enabled) -> void { enabled_.store(enabled, std::memory_order_relaxed); }
+	auto IsEnabled() const -> bool { return enabled_.load(std::memory_order_relaxed); }
+
+	/**
+	 * \brief number of scopes open on the calling thread
+	 */
+	static auto CurrentDepth() -> std::uint32_t { return Depth(); }
+
+	/**
+	 * \brief RAII timer, records on destruction; item may be empty for a phase scope
+	 *
+	 * Names are copied, and only while the profiler is enabled.
+	 */
+	class Scope final {
+	public:
+		Scope(const std::string_view phase, const std::string_view item = {}) {
+			auto& profiler = Instance();
+			if (!profiler.IsEnabled()) return;
+			active_ = true;
+			phase_  = phase;
+			item_   = item;
+			depth_  = Depth()++;
+			start_  = Clock::now();
+		}
+
+		Scope(const Scope&)                    = delete;
+		auto operator=(const Scope&) -> Scope& = delete;
+
+		~Scope() {
+			if (!active_) return;
+			--Depth();
+			Instance().Record(phase_, item_, start_, Clock::now(), depth_);
+		}
+
+	private:
+		bool             active_{ false };
+		std::string      phase_;
+		std::string      item_;
+		std::uint32_t    depth_{ 0 };
+		Clock::time_point start_;
+	};
+
+	/**
+	 * \brief record an interval timed elsewhere, e.g. by a loop that already reads the clock
+	 *
+	 * depth defaults to the scopes open on the calling thread, as for a Scope opened here.
+	 */
+	auto Record(const std::string_view phase, const std::string_view item, const Clock::time_point start, const Clock::time_point end, const std::uint32_t depth = CurrentDepth()) -> void {
+		if (!IsEnabled()) return;
+		Entry entry{ std::string(phase), std::string(item), Since(start), Since(end) - Since(start), CurrentTid(), depth };
+		std::lock_guard lock(mutex_);
+		entries_.push_back(std::move(entry));
+	}
+
+	auto Clear() -> void {
+		std::lock_guard lock(mutex_);
+		entries_.clear();
+	}
+
+	auto Entries() const -> std::vector<Entry> {
+		std::lock_guard lock(mutex_);
+		return entries_;
+	}
+
+	/**
+	 * \brief per-phase totals in order of first appearance
+	 */
+	auto Totals() const -> std::vector<PhaseTotal> {
+		std::vector<PhaseTotal> totals;
+		std::unordered_map<std::string, size_t> index;
+		std::vector<bool> scoped;
+
+		std::lock_guard lock(mutex_);
+		for (const auto& entry : entries_) {
+			auto [it, inserted] = index.emplace(entry.phase, totals.size());
+			if (inserted) {
+				totals.push_back({ entry.phase, 0, 0, 0 });
+				scoped.push_back(false);
+			}
+
+			auto& total = totals[it->second];
+			if (entry.item.empty()) {
+				total.totalNs += entry.durationNs;
+				scoped[it->second] = true;
+			} else {
+				total.itemNs += entry.durationNs;
+				total.items++;
+			}
+		}
+
+		for (size_t i = 0; i < totals.size(); i++)
+			if (!scoped[i]) totals[i].totalNs = totals[i].itemNs;
+		return totals;
+	}
+
+	/**
+	 * \brief the `count` slowest items over all phases
+	 */
+	auto Slowest(const size_t count = 10) const -> std::vector<Entry> {
+		std::vector<Entry> items;
+		{
+			std::lock_guard lock(mutex_);
+			for (const auto& entry : entries_)
+				if (!entry.item.empty()) items.push_back(entry);
+		}
+
+		const auto n = std::min(count, items.size());
+		std::partial_sort(items.begin(), items.begin() + n, items.end(), [](const Entry& l, const Entry& r) { return l.durationNs > r.durationNs; });
+		items.resize(n);
+		return items;
+	}
+
+	auto Report(const size_t slowest = 10) const -> std::string {
+		std::string out;
+		char        line[512];
+		for (const auto& total : Totals()) {
+			snprintf(line, sizeof(line), "%-32s %10.3f ms  %zu items %10.3f ms\n", total.phase.c_str(), total.totalNs / 1e6, total.items, total.itemNs / 1e6);
+			out += line;
+		}
+
+		for (const auto& entry : Slowest(slowest)) {
+			snprintf(line, sizeof(line), "  %10.3f ms  %s  %s\n", entry.durationNs / 1e6, entry.phase.c_str(), entry.item.c_str());
+			out += line;
+		}
+		return out;
+	}
+
+	/**
+	 * \brief {"phases":[{name,total_ms,items,item_ms}],"slowest":[...],"entries":[{phase,item,start_us,duration_us,tid,depth}]}
+	 */
+	auto ToJson(const size_t slowest = 10) const -> std::string {
+		std::string out = "{\"phases\":[";
+		char        num[96];
+		bool        first = true;
+		for (const auto& total : Totals()) {
+			out += first ? "{\"name\":" : ",{\"name\":";
+			AppendQuoted(out, total.phase);
+			snprintf(num, sizeof(num), ",\"total_ms\":%.3f,\"items\":%zu,\"item_ms\":%.3f}", total.totalNs / 1e6, total.items, total.itemNs / 1e6);
+			out += num;
+			first = false;
+		}
+
+		const auto appendEntries = [&](const std::vector<Entry>& entries) {
+			first = true;
+			for (const auto& entry : entries) {
+				out += first ? "{\"phase\":" : ",{\"phase\":";
+				AppendQuoted(out, entry.phase);
+				out += ",\"item\":";
+				AppendQuoted(out, entry.item);
+				snprintf(num, sizeof(num), ",\"start_us\":%.3f,\"duration_us\":%.3f,\"tid\":%" PRIu32 ",\"depth\":%" PRIu32 "}", entry.startNs / 1e3, entry.durationNs / 1e3, entry.tid, entry.depth);
+				out += num;
+				first = false;
+			}
+		};
+
+		out += "],\"slowest\":[";
+		appendEntries(Slowest(slowest));
+		out += "],\"entries\":[";
+		appendEntries(Entries());
+		out += "]}";
+		return out;
+	}
+
+	/**
+	 * \brief Trace Event Format, complete ("X") events; phases are the category
+	 */
+	auto ToChromeTrace() const -> std::string {
+		std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		char        num[128];
+		bool        first = true;
+		const auto  pid   = static_cast<int>(getpid());
+		for (const auto& entry : Entries()) {
+			out += first ? "{\"name\":" : ",{\"name\":";
+			AppendQuoted(out, entry.item.empty() ? entry.phase : entry.item);
+			out += ",\"cat\":";
+			AppendQuoted(out, entry.phase);
+			snprintf(num, sizeof(num), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%" PRIu32 "}", entry.startNs / 1e3, entry.durationNs / 1e3, pid, entry.tid);
+			out += num;
+			first = false;
+		}
+		out += "]}";
+		return out;
+	}
+
+	static auto WriteFile(const std::string& path, const std::string& content) -> bool {
+		FILE* file = fopen(path.c_str(), "wb");
+		if (!file) return false;
+		const bool ok = fwrite(content.data(), 1, content.size(), file) == content.size();
+		return fclose(file) == 0 && ok;
+	}
+
+private:
+	StartupProfiler() : epoch_(Clock::now()) {}
+
+	static auto Depth() -> std::uint32_t& {
+		thread_local std::uint32_t depth = 0;
+		return depth;
+	}
+
+	auto Since(const Clock::time_point time) const -> std::uint64_t {
+		return time > epoch_ ? static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time - epoch_).count()) : 0;
+	}
+
+	static auto CurrentTid() -> std::uint32_t {
+		thread_local const auto tid = static_cast<std::uint32_t>(syscall(SYS_gettid));
+		return tid;
+	}
+
+	static auto AppendQuoted(std::string& out, const std::string_view text) -> void {
+		out += '"';
+		for (const char c : text) {
+			switch (c) {
+				case '"': out += "\\\""; break;
+				case '\\': out += "\\\\"; break;
+				case '\n': out += "\\n"; break;
+				case '\t': out += "\\t"; break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20) {
+						char escaped[8];
+						snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+						out += escaped;
+					} else out += c;
+			}
+		}
+		out += '"';
+	}
+
+	const Clock::time_point epoch_;
+	std::atomic<bool>       enabled_{ false };
+	mutable std::mutex      mutex_;
+	std::vector<Entry>      entries_;
+};
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "json.hpp"
+#include "BufferedWriter.hpp"
+#include "MetadataReader.hpp"
+
+/**
+ * \brief offline generator of RVA / field offset headers for the il2cpp-Amongus appdata
+ *
+ * Reads a dump of the game (a .urmd from UnityResolve::DumpToBinary, or a DumpToJson document
+ * plus the image base it was taken at) and the hand-maintained signature lists
+ * (il2cpp-functions.h, il2cpp-classes.h), and writes:
+ *
+ *   il2cpp-rvas.h     DO_APP_RVA(name, rva); per DO_APP_FUNC whose signature matched
+ *                     exactly one method, an X-macro list like il2cpp-functions.h
+ *   il2cpp-offsets.h  app::offsets::<Class>::<field> constexpr offsets for every class the
+ *                     lists reference
+ *
+ * Signatures are matched like find_method does at runtime: method name, return type and
+ * parameter type names, ignoring spaces. Entries that do not match are listed as comments
+ * and stay on the runtime lookup. Run() is the command line entry point:
+ *
+ *   int main(int argc, char** argv) { return AppDataGenerator::Run(argc, argv); }
+ */
+class AppDataGenerator final {
+public:
+	struct Field {
+		std::string  name;
+		std::string  type;
+		std::int32_t offset;
+		bool         isStatic;
+	};
+
+	struct Method {
+		std::string              name;
+		std::string              returnType;
+		std::vector<std::string> params;
+		std::uint64_t            rva; // 0 if unknown
+	};
+
+	struct Class {
+		std::string         assembly; // without ".dll"
+		std::string         namespaze;
+		std::string         name;
+		std::vector<Field>  fields;
+		std::vector<Method> methods;
+	};
+
+	/**
+	 * \brief one DO_APP_FUNC / DO_APP_CLASS line: the C++ name and the signature string
+	 */
+	struct Entry {
+		std::string name;
+		std::string signature;
+	};
+
+	struct Stats {
+		size_t                   functions{ 0 };
+		size_t                   resolved{ 0 };
+		size_t                   ambiguous{ 0 }; // several methods matched, the first one was used
+		size_t                   classes{ 0 };
+		size_t                   fields{ 0 };
+		std::vector<std::string> unresolved;
+	};
+
+	auto Load(const MetadataReader& reader) -> bool {
+		if (!reader.Ok()) return false;
+		classes_.clear();
+		for (const auto& assembly : reader.Assemblies()) {
+			const auto assemblyName = StripDll(reader.String(assembly.name));
+			for (const auto& record : reader.Classes(assembly)) {
+				Class klass{ std::string(assemblyName), std::string(reader.String(record.namespaze)), std::string(reader.String(record.name)), {}, {} };
+				for (const auto& field : reader.Fields(record))
+					klass.fields.push_back({ std::string(reader.String(field.name)), std::string(reader.TypeName(field.type)), field.offset, (field.attrs & UnityMetadata::FieldStatic) != 0 });
+				for (const auto& method : reader.Methods(record)) {
+					Method out{ std::string(reader.String(method.name)), std::string(reader.TypeName(method.returnType)), {}, (method.attrs & UnityMetadata::MethodBadPtr) ? 0 : method.rva };
+					for (const auto& arg : reader.Args(method)) out.params.emplace_back(reader.TypeName(arg.type));
+					klass.methods.push_back(std::move(out));
+				}
+				classes_.push_back(std::move(klass));
+			}
+		}
+		Index();
+		return true;
+	}
+
+	/**
+	 * \brief load a DumpToJson document; method addresses in it are absolute, imageBase turns them into RVAs
+	 */
+	auto Load(const nlohmann::json& dump, const std::uint64_t imageBase) -> bool {
+		if (!dump.is_array()) return false;
+		classes_.clear();
+		const auto typeName = [](const nlohmann::json& type) { return type.is_object() ? type.value("name", std::string{}) : std::string{}; };
+		for (const auto& assembly : dump) {
+			const auto name         = assembly.value("name", std::string{});
+			const auto assemblyName = StripDll(name);
+			for (const auto& record : assembly.value("classes", nlohmann::json::array())) {
+				Class klass{ std::string(assemblyName), record.value("namespace", std::string{}), record.value("name", std::string{}), {}, {} };
+				for (const auto& field : record.value("fields", nlohmann::json::array()))
+					klass.fields.push_back({ field.value("name", std::string{}), typeName(field.value("type", nlohmann::json{})), field.value("offset", -1), field.value("static_field", false) });
+				for (const auto& method : record.value("methods", nlohmann::json::array())) {
+					const auto function = method.value("function", std::uint64_t{ 0 });
+					const bool bad      = method.value("badPtr", false) || function < imageBase;
+					Method out{ method.value("name", std::string{}), typeName(method.value("return_type", nlohmann::json{})), {}, bad ? 0 : function - imageBase };
+					for (const auto& arg : method.value("args", nlohmann::json::array()))
+						out.params.push_back(arg.is_object() ? typeName(arg.value("type", nlohmann::json{})) : std::string{});
+					klass.methods.push_back(std::move(out));
+				}
+				classes_.push_back(std::move(klass));
+			}
+		}
+		Index();
+		return true;
+	}
+
+	/**
+	 * \brief pull NAME and the signature literal out of every `macro(..., NAME, ..., "sig");` line
+	 *
+	 * The name is the second argument for DO_APP_FUNC and the first for DO_APP_CLASS; lines
+	 * commented out with // are skipped.
+	 */
+	static auto ParseEntries(const std::string_view header, const std::string_view macro) -> std::vector<Entry> {
+		const size_t nameArg = macro == "DO_APP_CLASS" ? 0 : 1;
+		std::vector<Entry> entries;
+		size_t lineStart = 0;
+		while (lineStart < header.size()) {
+			auto lineEnd = header.find('\n', lineStart);
+			if (lineEnd == std::string_view::npos) lineEnd = header.size();
+			auto line = header.substr(lineStart, lineEnd - lineStart);
+			lineStart = lineEnd + 1;
+
+			const auto first = line.find_first_not_of(" \t");
+			if (first == std::string_view::npos || line.substr(first, macro.size()) != macro) continue;
+			line.remove_prefix(first + macro.size());
+
+			const auto open  = line.find('(');
+			const auto quote = line.rfind('"');
+			const auto start = quote == std::string_view::npos || quote == 0 ? std::string_view::npos : line.rfind('"', quote - 1);
+			if (open == std::string_view::npos || start == std::string_view::npos) continue;
+
+			// arguments split on top-level commas, parenthesized parameter lists count as one
+			std::string_view name;
+			size_t arg = 0, depth = 0, argStart = open + 1;
+			for (size_t i = open + 1; i < start && name.empty(); i++) {
+				if (line[i] == '(') depth++;
+				else if (line[i] == ')') depth--;
+				else if (line[i] == ',' && depth == 0) {
+					if (arg++ == nameArg) name = Trim(line.substr(argStart, i - argStart));
+					argStart = i + 1;
+				}
+			}
+			if (!name.empty()) entries.push_back({ std::string(name), std::string(line.substr(start + 1, quote - start - 1)) });
+		}
+		return entries;
+	}
+
+	/**
+	 * \brief class named by an "Assembly, Namespace.Class" or method signature, nullptr if unknown
+	 *
+	 * Also nullptr if the name is ambiguous: nested types are dumped under their own name
+	 * without the declaring class, so names like <>c or Enumerator repeat within an assembly
+	 * and cannot be told apart.
+	 */
+	[[nodiscard]] auto FindClass(std::string_view assembly, std::string_view fullName) const -> const Class* {
+		const auto it = byName_.find(Key(StripDll(assembly), fullName));
+		if (it != byName_.end()) return it->second == kAmbiguous ? nullptr : &classes_[it->second];
+
+		const auto plus = fullName.rfind('+');
+		if (plus == std::string_view::npos) return nullptr;
+		const auto nested = byName_.find(Key(StripDll(assembly), fullName.substr(plus + 1)));
+		return nested != byName_.end() && nested->second != kAmbiguous ? &classes_[nested->second] : nullptr;
+	}
+
+	/**
+	 * \brief the method a DO_APP_FUNC signature names; `matches` gets the number of distinct candidates
+	 */
+	[[nodiscard]] auto FindMethod(const std::string_view signature, size_t* matches = nullptr) const -> const Method* {
+		if (matches) *matches = 0;
+		Signature sig;
+		if (!Parse(signature, sig)) return nullptr;
+		const auto klass = FindClass(sig.assembly, sig.klass);
+		if (!klass) return nullptr;
+
+		const Method* found = nullptr;
+		for (const auto& method : klass->methods) {
+			if (method.name != sig.method || !SameType(method.returnType, sig.returnType)) continue;
+			std::string params;
+			for (size_t i = 0; i < method.params.size(); i++) {
+				if (i) params += ',';
+				params += method.params[i];
+			}
+			if (!SameType(params, sig.params)) continue;
+			// parent methods are dumped again under the derived class, only distinct RVAs count
+			if (!found) found = &method;
+			else if (method.rva == found->rva) continue;
+			if (matches) ++*matches;
+		}
+		return found;
+	}
+
+	auto WriteRvas(BufferedWriter& out, const std::vector<Entry>& functions, const std::string& source) const -> Stats {
+		Stats stats;
+		stats.functions = functions.size();
+		out.Write("// Generated by AppDataGenerator from ");
+		out.Write(source);
+		out.Write(", do not edit.\n// DO_APP_RVA(name, rva): RVA of the DO_APP_FUNC of the same name, relative to GameAssembly.\n\n");
+		for (const auto& entry : functions) {
+			size_t matches = 0;
+			const auto method = FindMethod(entry.signature, &matches);
+			if (!method || method->rva == 0) {
+				stats.unresolved.push_back(entry.name);
+				out.Format("// unresolved: %s \"%s\"\n", entry.name.c_str(), entry.signature.c_str());
+				continue;
+			}
+			if (matches > 1) stats.ambiguous++;
+			stats.resolved++;
+			out.Format("DO_APP_RVA(%s, 0x%llx);\n", entry.name.c_str(), static_cast<unsigned long long>(method->rva));
+		}
+		return stats;
+	}
+
+	/**
+	 * \brief offsets of every class named by `classes` (DO_APP_CLASS) or declaring one of `functions`
+	 */
+	auto WriteOffsets(BufferedWriter& out, const std::vector<Entry>& classes, const std::vector<Entry>& functions, const std::string& source, Stats& stats) const -> void {
+		out.Write("// Generated by AppDataGenerator from ");
+		out.Write(source);
+		out.Write(", do not edit.\n#pragma once\n#include <cstdint>\n\nnamespace app::offsets {\n");
+
+		std::unordered_set<const Class*> written;
+		std::unordered_set<std::string>  names;
+		const auto writeClass = [&](const Class* klass, std::string name) {
+			if (!klass || !written.insert(klass).second) return;
+			while (!names.insert(name).second) name += '_';
+			stats.classes++;
+
+			out.Format("\tnamespace %s { // %s, %s%s%s\n", name.c_str(), klass->assembly.c_str(), klass->namespaze.c_str(), klass->namespaze.empty() ? "" : ".", klass->name.c_str());
+			std::unordered_set<std::string> fields;
+			for (const bool statics : { false, true }) {
+				bool opened = false;
+				for (const auto& field : klass->fields) {
+					if (field.isStatic != statics || field.offset < 0) continue;
+					auto id = Identifier(field.name);
+					if (!fields.insert((statics ? "s:" : "i:") + id).second) continue; // parent fields are dumped again
+					if (statics && !opened) {
+						out.Write("\t\tnamespace statics {\n");
+						opened = true;
+					}
+					out.Format("%sconstexpr std::int32_t %s = 0x%x; // %s\n", statics ? "\t\t\t" : "\t\t", id.c_str(), field.offset, field.type.c_str());
+					stats.fields++;
+				}
+				if (opened) out.Write("\t\t}\n");
+			}
+			out.Write("\t}\n");
+		};
+
+		for (const auto& entry : classes) {
+			Signature sig;
+			if (ParseClass(entry.signature, sig)) writeClass(FindClass(sig.assembly, sig.klass), entry.name);
+		}
+		for (const auto& entry : functions) {
+			Signature sig;
+			if (!Parse(entry.signature, sig)) continue;
+			const auto klass = FindClass(sig.assembly, sig.klass);
+			if (klass) writeClass(klass, Identifier(klass->namespaze.empty() ? klass->name : klass->namespaze + "_" + klass->name));
+		}
+		out.Write("}\n");
+	}
+
+	/**
+	 * \brief appdata-gen <dump.urmd | dump.json BASE> <il2cpp-functions.h> <il2cpp-classes.h> <out-dir>
+	 */
+	static auto Run(const int argc, char** argv) -> int {
+		const bool json = argc == 6;
+		if (argc != 5 && !json) {
+			fprintf(stderr, "usage: %s <dump.urmd | dump.json image-base> <il2cpp-functions.h> <il2cpp-classes.h> <out-dir>\n", argc ? argv[0] : "appdata-gen");
+			return 2;
+		}
+
+		AppDataGenerator generator;
+		const std::string dump = argv[1];
+		if (json) {
+			std::ifstream in(dump);
+			const auto document = nlohmann::json::parse(in, nullptr, false);
+			if (document.is_discarded() || !generator.Load(document, std::stoull(argv[2], nullptr, 0))) {
+				fprintf(stderr, "cannot read %s\n", dump.c_str());
+				return 1;
+			}
+		} else {
+			MetadataReader reader(dump);
+			if (!generator.Load(reader)) {
+				fprintf(stderr, "cannot read %s\n", dump.c_str());
+				return 1;
+			}
+		}
+
+		const auto read = [](const char* path) {
+			std::ifstream in(path);
+			std::stringstream buffer;
+			buffer << in.rdbuf();
+			return buffer.str();
+		};
+		const auto functions = ParseEntries(read(argv[argc - 3]), "DO_APP_FUNC");
+		const auto classes   = ParseEntries(read(argv[argc - 2]), "DO_APP_CLASS");
+		const std::string outDir = argv[argc - 1];
+		const auto source = dump.substr(dump.find_last_of('/') + 1);
+
+		BufferedWriter rvas(outDir + "/il2cpp-rvas.h");
+		auto stats = generator.WriteRvas(rvas, functions, source);
+		BufferedWriter offsets(outDir + "/il2cpp-offsets.h");
+		generator.WriteOffsets(offsets, classes, functions, source, stats);
+		if (!rvas.Flush() || !offsets.Flush()) {
+			fprintf(stderr, "cannot write to %s\n", outDir.c_str());
+			return 1;
+		}
+
+		printf("%zu/%zu functions resolved (%zu ambiguous), %zu classes, %zu fields\n", stats.resolved, stats.functions, stats.ambiguous, stats.classes, stats.fields);
+		for (const auto& name : stats.unresolved) printf("unresolved: %s\n", name.c_str());
+		return stats.unresolved.empty() ? 0 : 3;
+	}
+
+private:
+	struct Signature {
+		std::string_view assembly;
+		std::string_view returnType;
+		std::string_view klass; // "Namespace.Class"
+		std::string_view method;
+		std::string_view params;
+	};
+
+	// "Assembly, Return Namespace.Class::Method(Params)", same grammar as parse_method_signature
+	static auto Parse(std::string_view signature, Signature& out) -> bool {
+		auto pos = signature.find(", ");
+		if (pos == std::string_view::npos) return false;
+		out.assembly = signature.substr(0, pos);
+		signature.remove_prefix(pos + 2);
+
+		if ((pos = signature.find(' ')) == std::string_view::npos) return false;
+		out.returnType = signature.substr(0, pos);
+		signature.remove_prefix(pos + 1);
+
+		const auto open = signature.find('(');
+		if (open == std::string_view::npos || signature.back() != ')') return false;
+		out.params = signature.substr(open + 1, signature.size() - open - 2);
+		if ((pos = signature.rfind("::", open)) == std::string_view::npos) return false;
+		out.method = signature.substr(pos + 2, open - pos - 2);
+		out.klass  = signature.substr(0, pos);
+		return true;
+	}
+
+	static auto ParseClass(const std::string_view signature, Signature& out) -> bool {
+		const auto pos = signature.find(", ");
+		if (pos == std::string_view::npos) return false;
+		out.assembly = signature.substr(0, pos);
+		out.klass    = signature.substr(pos + 2);
+		return true;
+	}
+
+	static auto SameType(const std::string_view a, const std::string_view b) -> bool {
+		size_t i = 0, j = 0;
+		while (true) {
+			while (i < a.size() && a[i] == ' ') i++;
+			while (j < b.size() && b[j] == ' ') j++;
+			if (i == a.size() || j == b.size()) return i == a.size() && j == b.size();
+			if (a[i++] != b[j++]) return false;
+		}
+	}
+
+	static auto StripDll(const std::string_view name) -> std::string_view {
+		return name.size() > 4 && name.substr(name.size() - 4) == ".dll" ? name.substr(0, name.size() - 4) : name;
+	}
+
+	static auto Trim(std::string_view str) -> std::string_view {
+		while (!str.empty() && std::isspace(static_cast<unsigned char>(str.front()))) str.remove_prefix(1);
+		while (!str.empty() && std::isspace(static_cast<unsigned char>(str.back()))) str.remove_suffix(1);
+		return str;
+	}
+
+	// "<Name>k__BackingField" -> "_Name_k__BackingField"
+	static auto Identifier(const std::string_view name) -> std::string {
+		std::string id;
+		for (const auto c : name) id += std::isalnum(static_cast<unsigned char>(c)) || c == '_' ? c : '_';
+		if (id.empty() || std::isdigit(static_cast<unsigned char>(id.front()))) id.insert(id.begin(), '_');
+		return id;
+	}
+
+	static auto Key(const std::string_view assembly, const std::string_view fullName) -> std::string {
+		std::string key(assembly);
+		key += '|';
+		key += fullName;
+		return key;
+	}
+
+	// byName_ value of a name shared by several classes
+	static constexpr size_t kAmbiguous = static_cast<size_t>(-1);
+
+	auto Index() -> void {
+		byName_.clear();
+		for (size_t i = 0; i < classes_.size(); i++) {
+			const auto& klass = classes_[i];
+			const auto [it, inserted] = byName_.emplace(Key(klass.assembly, klass.namespaze.empty() ? klass.name : klass.namespaze + "." + klass.name), i);
+			if (!inserted) it->second = kAmbiguous;
+		}
+	}
+
+	std::vector<Class>                      classes_;
+	std::unordered_map<std::string, size_t> byName_; // kAmbiguous if the name repeats
+};
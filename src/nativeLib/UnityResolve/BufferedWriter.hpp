@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * \brief fixed-size output buffer in front of a file descriptor
+ *
+ * Dumps go through here so that serializing a whole metadata model costs a
+ * handful of large write(2) calls and a constant amount of memory, no matter
+ * how many tokens are produced. Errors are sticky: once a write fails every
+ * later call is a no-op and Ok() returns false.
+ */
+class BufferedWriter final {
+public:
+	explicit BufferedWriter(int fd, size_t capacity = 1 << 16, bool ownsFd = false)
+		: fd_(fd), ownsFd_(ownsFd), failed_(fd < 0), capacity_(capacity), buffer_(new char[capacity]) {}
+
+	explicit BufferedWriter(const std::string& path, size_t capacity = 1 << 16)
+		: BufferedWriter(open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644), capacity, true) {}
+
+	BufferedWriter(const BufferedWriter&) = delete;
+	auto operator=(const BufferedWriter&) -> BufferedWriter& = delete;
+
+	~BufferedWriter() {
+		Flush();
+		if (ownsFd_ && fd_ >= 0) close(fd_);
+	}
+
+	[[nodiscard]] auto Ok() const -> bool { return !failed_; }
+
+	[[nodiscard]] auto BytesWritten() const -> std::uint64_t { return flushed_ + used_; }
+
+	auto Write(const void* data, size_t len) -> bool {
+		if (failed_) return false;
+		if (len > capacity_ - used_) {
+			if (!Flush()) return false;
+			// large blocks skip the buffer entirely
+			if (len >= capacity_) {
+				if (!WriteAll(static_cast<const char*>(data), len)) return false;
+				flushed_ += len;
+				return true;
+			}
+		}
+		memcpy(buffer_.get() + used_, data, len);
+		used_ += len;
+		return true;
+	}
+
+	auto Write(const std::string& str) -> bool { return Write(str.data(), str.size()); }
+
+	auto Write(const char* str) -> bool { return Write(str, strlen(str)); }
+
+	auto Put(const char c) -> bool {
+		if (used_ == capacity_ && !Flush()) return false;
+		if (failed_) return false;
+		buffer_[used_++] = c;
+		return true;
+	}
+
+	/**
+	 * \brief printf straight into the buffer, falling back to a heap string for oversized output
+	 */
+	__attribute__((format(printf, 2, 3))) auto Format(const char* fmt, ...) -> bool {
+		if (failed_) return false;
+		if (capacity_ - used_ < 256 && !Flush()) return false;
+
+		va_list args;
+		va_start(args, fmt);
+		const auto room = capacity_ - used_;
+		const auto len  = vsnprintf(buffer_.get() + used_, room, fmt, args);
+		va_end(args);
+		if (len < 0) return false;
+		if (static_cast<size_t>(len) < room) {
+			used_ += len;
+			return true;
+		}
+
+		std::string big(len + 1, '\0');
+		va_start(args, fmt);
+		vsnprintf(&big[0], big.size(), fmt, args);
+		va_end(args);
+		return Write(big.data(), len);
+	}
+
+	auto Flush() -> bool {
+		if (failed_) return false;
+		if (used_ == 0) return true;
+		if (!WriteAll(buffer_.get(), used_)) return false;
+		flushed_ += used_;
+		used_ = 0;
+		return true;
+	}
+
+private:
+	auto WriteAll(const char* data, size_t len) -> bool {
+		while (len > 0) {
+			const auto n = write(fd_, data, len);
+			if (n < 0) {
+				if (errno == EINTR) continue;
+				failed_ = true;
+				return false;
+			}
+			data += n;
+			len -= n;
+		}
+		return true;
+	}
+
+	int                     fd_;
+	bool                    ownsFd_;
+	bool                    failed_;
+	size_t                  capacity_;
+	size_t                  used_{ 0 };
+	std::uint64_t           flushed_{ 0 };
+	std::unique_ptr<char[]> buffer_;
+};
+
+#ifdef UNITY_RESOLVE_USE_MINIZ
+#include "miniz.h"
+
+/**
+ * \brief gzip (RFC 1952) stream on top of a BufferedWriter, using the bundled miniz deflate
+ */
+class GzipWriter final {
+public:
+	explicit GzipWriter(BufferedWriter& out, int level = MZ_DEFAULT_LEVEL) : out_(out) {
+		memset(&stream_, 0, sizeof(stream_));
+		initialized_ = mz_deflateInit2(&stream_, level, MZ_DEFLATED, -MZ_DEFAULT_WINDOW_BITS, 9, MZ_DEFAULT_STRATEGY) == MZ_OK;
+		failed_ = !initialized_;
+
+		static const unsigned char header[10] = { 0x1f, 0x8b, 0x08, 0, 0, 0, 0, 0, 0, 0x03 };
+		if (!failed_) failed_ = !out_.Write(header, sizeof(header));
+	}
+
+	GzipWriter(const GzipWriter&) = delete;
+	auto operator=(const GzipWriter&) -> GzipWriter& = delete;
+
+	~GzipWriter() {
+		Finish();
+		if (initialized_) mz_deflateEnd(&stream_);
+	}
+
+	[[nodiscard]] auto Ok() const -> bool { return !failed_ && out_.Ok(); }
+
+	auto Write(const void* data, size_t len) -> bool {
+		if (failed_ || finished_) return false;
+		crc_ = mz_crc32(crc_, static_cast<const unsigned char*>(data), len);
+		size_ += len;
+		return Deflate(data, len, MZ_NO_FLUSH);
+	}
+
+	auto Write(const std::string& str) -> bool { return Write(str.data(), str.size()); }
+
+	auto Finish() -> bool {
+		if (finished_) return Ok();
+		finished_ = true;
+		if (failed_ || !Deflate(nullptr, 0, MZ_FINISH)) return false;
+
+		unsigned char trailer[8];
+		for (int i = 0; i < 4; i++) {
+			trailer[i]     = static_cast<unsigned char>(crc_ >> (8 * i));
+			trailer[4 + i] = static_cast<unsigned char>(size_ >> (8 * i));
+		}
+		return out_.Write(trailer, sizeof(trailer)) && out_.Flush();
+	}
+
+private:
+	auto Deflate(const void* data, size_t len, int flush) -> bool {
+		stream_.next_in  = static_cast<const unsigned char*>(data);
+		stream_.avail_in = static_cast<unsigned int>(len);
+		for (;;) {
+			stream_.next_out  = chunk_;
+			stream_.avail_out = sizeof(chunk_);
+			const auto status = mz_deflate(&stream_, flush);
+			if (status != MZ_OK && status != MZ_STREAM_END && status != MZ_BUF_ERROR) {
+				failed_ = true;
+				return false;
+			}
+			const auto produced = sizeof(chunk_) - stream_.avail_out;
+			if (produced && !out_.Write(chunk_, produced)) {
+				failed_ = true;
+				return false;
+			}
+			if (flush == MZ_FINISH ? status == MZ_STREAM_END : (stream_.avail_in == 0 && stream_.avail_out != 0)) return true;
+		}
+	}
+
+	BufferedWriter& out_;
+	mz_stream       stream_;
+	bool            initialized_{ false };
+	bool            failed_{ false };
+	bool            finished_{ false };
+	mz_ulong        crc_{ MZ_CRC32_INIT };
+	std::uint64_t   size_{ 0 };
+	unsigned char   chunk_[1 << 15];
+};
+#endif
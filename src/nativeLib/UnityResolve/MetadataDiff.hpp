@@ -0,0 +1,380 @@
+#pragma once
+
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "BufferedWriter.hpp"
+#include "MetadataReader.hpp"
+
+/**
+ * \brief structural diff between two .urmd dumps of the same game, e.g. across an update
+ *
+ * Classes are paired in three passes, each only looking at what the previous ones left over:
+ *
+ *   1. same assembly, namespace and name
+ *   2. same structural fingerprint (field types and offsets, method signatures), when the
+ *      fingerprint is unique on both sides; this catches classes renamed by obfuscation
+ *   3. best member-signature similarity above Options::minSimilarity among candidates of
+ *      similar size in the same assembly
+ *
+ * Type names that are not System.* / UnityEngine.* are treated as opaque because obfuscators
+ * rename them too. Passes 1 and 2 are hash joins; pass 3 is bounded by maxCandidates, so 50k
+ * class inputs finish in well under a second. Members of paired classes are then matched by
+ * name, falling back to signature, and WriteRemap() emits the resulting remap table.
+ */
+class MetadataDiff final {
+public:
+	enum class How : std::uint8_t { Name, Fingerprint, Similarity };
+
+	struct Options {
+		double minSimilarity{ 0.6 };
+		size_t maxCandidates{ 64 }; // per unmatched class in pass 3
+	};
+
+	struct ClassMatch {
+		std::uint32_t a;
+		std::uint32_t b;
+		How           how;
+		float         score;
+	};
+
+	struct MemberMatch {
+		std::uint32_t a; // global field / method id
+		std::uint32_t b;
+	};
+
+	std::vector<ClassMatch>    classes;
+	std::vector<MemberMatch>   fields;
+	std::vector<MemberMatch>   methods;
+	std::vector<std::uint32_t> removed; // class ids only in a
+	std::vector<std::uint32_t> added;   // class ids only in b
+	size_t                     comparisons{ 0 }; // pass 3 similarity scores computed, at most maxCandidates per class of a
+
+	MetadataDiff(const MetadataReader& a, const MetadataReader& b) : MetadataDiff(a, b, Options{}) {}
+
+	MetadataDiff(const MetadataReader& a, const MetadataReader& b, const Options& options) : a_(a), b_(b), options_(options) {
+		const auto sa = Summarize(a_);
+		const auto sb = Summarize(b_);
+		std::vector<std::uint32_t> pairOfA(sa.size(), UnityMetadata::kNone);
+		std::vector<std::uint32_t> pairOfB(sb.size(), UnityMetadata::kNone);
+
+		const auto pair = [&](std::uint32_t x, std::uint32_t y, How how, float score) {
+			pairOfA[x] = y;
+			pairOfB[y] = x;
+			classes.push_back({ x, y, how, score });
+		};
+
+		// 1. by name
+		{
+			std::unordered_map<std::uint64_t, std::uint32_t> byName;
+			for (std::uint32_t y = 0; y < sb.size(); y++) {
+				const auto it = byName.emplace(sb[y].nameKey, y);
+				if (!it.second) it.first->second = UnityMetadata::kNone; // ambiguous, leave to later passes
+			}
+			for (std::uint32_t x = 0; x < sa.size(); x++) {
+				const auto it = byName.find(sa[x].nameKey);
+				if (it == byName.end() || it->second == UnityMetadata::kNone || pairOfB[it->second] != UnityMetadata::kNone) continue;
+				if (!SameName(a_.Classes()[x], b_.Classes()[it->second])) continue;
+				pair(x, it->second, How::Name, 1.0f);
+			}
+		}
+
+		// 2. by unique fingerprint
+		{
+			std::unordered_map<std::uint64_t, std::uint32_t> countA, byFingerprint;
+			for (std::uint32_t x = 0; x < sa.size(); x++)
+				if (pairOfA[x] == UnityMetadata::kNone) countA[sa[x].fingerprint]++;
+			for (std::uint32_t y = 0; y < sb.size(); y++) {
+				if (pairOfB[y] != UnityMetadata::kNone) continue;
+				const auto it = byFingerprint.emplace(sb[y].fingerprint, y);
+				if (!it.second) it.first->second = UnityMetadata::kNone;
+			}
+			for (std::uint32_t x = 0; x < sa.size(); x++) {
+				if (pairOfA[x] != UnityMetadata::kNone || countA[sa[x].fingerprint] != 1) continue;
+				const auto it = byFingerprint.find(sa[x].fingerprint);
+				if (it == byFingerprint.end() || it->second == UnityMetadata::kNone) continue;
+				pair(x, it->second, How::Fingerprint, 1.0f);
+			}
+		}
+
+		// 3. by similarity, greedy on the best scores first
+		{
+			std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> buckets;
+			for (std::uint32_t y = 0; y < sb.size(); y++)
+				if (pairOfB[y] == UnityMetadata::kNone) buckets[BucketKey(sb[y].assembly, sb[y].sizeClass)].push_back(y);
+
+			struct Candidate {
+				float         score;
+				std::uint32_t x, y;
+			};
+			std::vector<Candidate> candidates;
+			for (std::uint32_t x = 0; x < sa.size(); x++) {
+				if (pairOfA[x] != UnityMetadata::kNone || sa[x].members.empty()) continue;
+				size_t budget = options_.maxCandidates;
+				for (int d = -1; d <= 1 && budget; d++) {
+					const auto it = buckets.find(BucketKey(sa[x].assembly, sa[x].sizeClass + d));
+					if (it == buckets.end()) continue;
+					for (const auto y : it->second) {
+						if (budget == 0) break;
+						--budget;
+						comparisons++;
+						const auto score = Similarity(sa[x].members, sb[y].members);
+						if (score >= options_.minSimilarity) candidates.push_back({ score, x, y });
+					}
+				}
+			}
+			std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& l, const Candidate& r) { return l.score > r.score; });
+			for (const auto& c : candidates)
+				if (pairOfA[c.x] == UnityMetadata::kNone && pairOfB[c.y] == UnityMetadata::kNone) pair(c.x, c.y, How::Similarity, c.score);
+		}
+
+		for (std::uint32_t x = 0; x < sa.size(); x++)
+			if (pairOfA[x] == UnityMetadata::kNone) removed.push_back(x);
+		for (std::uint32_t y = 0; y < sb.size(); y++)
+			if (pairOfB[y] == UnityMetadata::kNone) added.push_back(y);
+
+		std::sort(classes.begin(), classes.end(), [](const ClassMatch& l, const ClassMatch& r) { return l.a < r.a; });
+		for (const auto& match : classes) MatchMembers(a_.Classes()[match.a], b_.Classes()[match.b]);
+	}
+
+	/**
+	 * \brief tab-separated remap table, one line per change:
+	 *
+	 *   class   <old>  <new>  name|fingerprint|similarity  <score>
+	 *   field   <old class>  <old name>  <old offset>  <new name>  <new offset>
+	 *   method  <old class>  <old name>  <argc>  <old rva>  <new name>  <new rva>
+	 *   -class  <old>
+	 *   +class  <new>
+	 *
+	 * Classes paired by name are not listed; fields only if renamed or moved; methods only if
+	 * renamed or moved in the image.
+	 */
+	auto WriteRemap(BufferedWriter& out) const -> bool {
+		static const char* how[] = { "name", "fingerprint", "similarity" };
+		size_t f = 0, m = 0;
+		for (const auto& match : classes) {
+			const auto& ca = a_.Classes()[match.a];
+			const auto& cb = b_.Classes()[match.b];
+			if (match.how != How::Name) {
+				out.Write("class\t");
+				WriteName(out, a_, ca);
+				out.Put('\t');
+				WriteName(out, b_, cb);
+				out.Format("\t%s\t%.3f\n", how[static_cast<int>(match.how)], match.score);
+			}
+
+			const auto fieldsEnd = ca.firstField + ca.fieldCount;
+			for (; f < fields.size() && fields[f].a < fieldsEnd; f++) {
+				const auto& fa = a_.Fields()[fields[f].a];
+				const auto& fb = b_.Fields()[fields[f].b];
+				if (fa.offset == fb.offset && a_.String(fa.name) == b_.String(fb.name)) continue;
+				out.Write("field\t");
+				WriteName(out, a_, ca);
+				WriteString(out, a_.String(fa.name));
+				out.Format("\t0x%x", static_cast<unsigned>(fa.offset));
+				WriteString(out, b_.String(fb.name));
+				out.Format("\t0x%x\n", static_cast<unsigned>(fb.offset));
+			}
+
+			const auto methodsEnd = ca.firstMethod + ca.methodCount;
+			for (; m < methods.size() && methods[m].a < methodsEnd; m++) {
+				const auto& ma = a_.Methods()[methods[m].a];
+				const auto& mb = b_.Methods()[methods[m].b];
+				if (ma.rva == mb.rva && a_.String(ma.name) == b_.String(mb.name)) continue;
+				out.Write("method\t");
+				WriteName(out, a_, ca);
+				WriteString(out, a_.String(ma.name));
+				out.Format("\t%u\t0x%llx", ma.argCount, static_cast<unsigned long long>(ma.rva));
+				WriteString(out, b_.String(mb.name));
+				out.Format("\t0x%llx\n", static_cast<unsigned long long>(mb.rva));
+			}
+		}
+		for (const auto x : removed) {
+			out.Write("-class\t");
+			WriteName(out, a_, a_.Classes()[x]);
+			out.Put('\n');
+		}
+		for (const auto y : added) {
+			out.Write("+class\t");
+			WriteName(out, b_, b_.Classes()[y]);
+			out.Put('\n');
+		}
+		return out.Flush();
+	}
+
+private:
+	struct Summary {
+		std::uint64_t              nameKey;
+		std::uint64_t              fingerprint;
+		std::uint32_t              assembly;  // hash of the assembly name
+		int                        sizeClass; // ~log2 of the member count
+		std::vector<std::uint32_t> members;   // sorted member signature hashes
+	};
+
+	static auto Mix(std::uint64_t h, std::uint64_t v) -> std::uint64_t {
+		h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+		return h;
+	}
+
+	static auto BucketKey(std::uint32_t assembly, int sizeClass) -> std::uint64_t {
+		return static_cast<std::uint64_t>(assembly) << 32 | static_cast<std::uint32_t>(sizeClass);
+	}
+
+	// stable across obfuscation: well-known types by name, everything else by size only
+	static auto TypeToken(const MetadataReader& r, std::uint32_t type) -> std::uint32_t {
+		if (type == UnityMetadata::kNone || type >= r.Types().size()) return 0;
+		const auto name = r.TypeName(type);
+		if (name.rfind("System.", 0) == 0 || name.rfind("UnityEngine.", 0) == 0) return UnityMetadata::Hash(name);
+		return 0x5bd1e995u ^ static_cast<std::uint32_t>(r.Types()[type].size);
+	}
+
+	static auto FieldSignature(const MetadataReader& r, const UnityMetadata::FieldRecord& field) -> std::uint32_t {
+		return static_cast<std::uint32_t>(Mix(TypeToken(r, field.type), field.attrs));
+	}
+
+	static auto MethodSignature(const MetadataReader& r, const UnityMetadata::MethodRecord& method) -> std::uint32_t {
+		auto h = Mix(TypeToken(r, method.returnType), method.attrs & UnityMetadata::MethodStatic);
+		h      = Mix(h, static_cast<std::uint32_t>(method.flags));
+		for (const auto& arg : r.Args(method)) h = Mix(h, TypeToken(r, arg.type));
+		return static_cast<std::uint32_t>(h ^ h >> 32) | 1u; // never collides with a field signature of 0
+	}
+
+	static auto Summarize(const MetadataReader& r) -> std::vector<Summary> {
+		std::vector<Summary> out(r.Classes().size());
+		for (std::uint32_t i = 0; i < out.size(); i++) {
+			const auto& klass    = r.Classes()[i];
+			const auto  assembly = klass.assembly < r.Assemblies().size() ? UnityMetadata::Hash(r.String(r.Assemblies()[klass.assembly].name)) : 0u;
+			auto&       s        = out[i];
+
+			s.assembly = assembly;
+			s.nameKey  = static_cast<std::uint64_t>(UnityMetadata::HashClass(r.String(klass.namespaze), r.String(klass.name))) << 32 | assembly;
+
+			std::uint64_t fp = Mix(assembly, klass.fieldCount * 31u + klass.methodCount);
+			for (const auto& field : r.Fields(klass)) {
+				const auto sig = FieldSignature(r, field);
+				fp             = Mix(Mix(fp, sig), static_cast<std::uint32_t>(field.offset));
+				s.members.push_back(sig);
+			}
+			for (const auto& method : r.Methods(klass)) {
+				const auto sig = MethodSignature(r, method);
+				fp             = Mix(fp, sig);
+				s.members.push_back(sig);
+			}
+			s.fingerprint = fp;
+			std::sort(s.members.begin(), s.members.end());
+
+			int size = 0;
+			for (auto n = s.members.size(); n > 1; n >>= 1) size++;
+			s.sizeClass = size;
+		}
+		return out;
+	}
+
+	// Dice coefficient over the two sorted signature multisets
+	static auto Similarity(const std::vector<std::uint32_t>& x, const std::vector<std::uint32_t>& y) -> float {
+		if (x.empty() && y.empty()) return 1.0f;
+		size_t i = 0, j = 0, common = 0;
+		while (i < x.size() && j < y.size()) {
+			if (x[i] < y[j]) i++;
+			else if (y[j] < x[i]) j++;
+			else {
+				common++;
+				i++;
+				j++;
+			}
+		}
+		return 2.0f * common / (x.size() + y.size());
+	}
+
+	auto SameName(const UnityMetadata::ClassRecord& x, const UnityMetadata::ClassRecord& y) const -> bool {
+		return a_.String(x.name) == b_.String(y.name) && a_.String(x.namespaze) == b_.String(y.namespaze);
+	}
+
+	static auto WriteName(BufferedWriter& out, const MetadataReader& r, const UnityMetadata::ClassRecord& klass) -> void {
+		const auto ns = r.String(klass.namespaze);
+		if (!ns.empty()) {
+			out.Write(ns.data(), ns.size());
+			out.Put('.');
+		}
+		const auto name = r.String(klass.name);
+		out.Write(name.data(), name.size());
+	}
+
+	// tab-prefixed column
+	static auto WriteString(BufferedWriter& out, std::string_view str) -> void {
+		out.Put('\t');
+		out.Write(str.data(), str.size());
+	}
+
+	/**
+	 * \brief pair members by name first, then renamed ones by signature and position
+	 */
+	auto MatchMembers(const UnityMetadata::ClassRecord& ca, const UnityMetadata::ClassRecord& cb) -> void {
+		const auto fa = a_.Fields(ca), fb = b_.Fields(cb);
+		MatchRuns(
+			ca.firstField, fa.size(), cb.firstField, fb.size(), fields,
+			[&](size_t i) { return a_.String(fa[i].name); }, [&](size_t j) { return b_.String(fb[j].name); },
+			[&](size_t i) { return FieldSignature(a_, fa[i]); }, [&](size_t j) { return FieldSignature(b_, fb[j]); });
+
+		const auto ma = a_.Methods(ca), mb = b_.Methods(cb);
+		MatchRuns(
+			ca.firstMethod, ma.size(), cb.firstMethod, mb.size(), methods,
+			[&](size_t i) { return a_.String(ma[i].name); }, [&](size_t j) { return b_.String(mb[j].name); },
+			[&](size_t i) { return MethodSignature(a_, ma[i]); }, [&](size_t j) { return MethodSignature(b_, mb[j]); });
+	}
+
+	template<typename NameA, typename NameB, typename SigA, typename SigB>
+	static auto MatchRuns(std::uint32_t firstA, size_t countA, std::uint32_t firstB, size_t countB, std::vector<MemberMatch>& out,
+						  NameA nameA, NameB nameB, SigA sigA, SigB sigB) -> void {
+		struct Key {
+			std::uint32_t name;
+			std::uint32_t sig;
+			std::uint32_t index;
+		};
+		std::vector<Key> keysB(countB);
+		for (std::uint32_t j = 0; j < countB; j++) keysB[j] = { UnityMetadata::Hash(nameB(j)), sigB(j), j };
+		std::sort(keysB.begin(), keysB.end(), [](const Key& l, const Key& r) { return l.name != r.name ? l.name < r.name : l.sig != r.sig ? l.sig < r.sig : l.index < r.index; });
+
+		std::vector<std::uint32_t> pairOfA(countA, UnityMetadata::kNone);
+		std::vector<char>          usedB(countB, 0);
+
+		// name + signature, then name alone (overloads keep their order)
+		for (int strict = 1; strict >= 0; strict--) {
+			for (std::uint32_t i = 0; i < countA; i++) {
+				if (pairOfA[i] != UnityMetadata::kNone) continue;
+				const auto name = UnityMetadata::Hash(nameA(i));
+				const auto sig  = sigA(i);
+				auto       it   = std::lower_bound(keysB.begin(), keysB.end(), name, [](const Key& k, std::uint32_t n) { return k.name < n; });
+				for (; it != keysB.end() && it->name == name; ++it) {
+					if (usedB[it->index] || (strict && it->sig != sig) || nameB(it->index) != nameA(i)) continue;
+					pairOfA[i]        = it->index;
+					usedB[it->index] = 1;
+					break;
+				}
+			}
+		}
+
+		// renamed: walk both leftovers in declaration order and pair equal signatures
+		size_t j = 0;
+		for (std::uint32_t i = 0; i < countA; i++) {
+			if (pairOfA[i] != UnityMetadata::kNone) continue;
+			const auto sig = sigA(i);
+			for (auto k = j; k < countB; k++) {
+				if (usedB[k] || sigB(k) != sig) continue;
+				pairOfA[i] = static_cast<std::uint32_t>(k);
+				usedB[k]   = 1;
+				j          = k + 1;
+				break;
+			}
+		}
+
+		for (std::uint32_t i = 0; i < countA; i++)
+			if (pairOfA[i] != UnityMetadata::kNone) out.push_back({ firstA + i, firstB + pairOfA[i] });
+	}
+
+	const MetadataReader& a_;
+	const MetadataReader& b_;
+	Options               options_;
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+/**
+ * \brief on-disk layout of the UnityResolve binary metadata dump (.urmd)
+ *
+ * Everything is little-endian and naturally aligned, so a reader can mmap the file and
+ * use the records in place. Sections follow the header in the order listed there, each
+ * starting on an 8 byte boundary:
+ *
+ *   strings     NUL-terminated UTF-8, referenced by byte offset; offset 0 is ""
+ *   types       TypeRecord, deduplicated by (name, size)
+ *   assemblies  AssemblyRecord, owning a contiguous run of classes
+ *   classes     ClassRecord, owning contiguous runs of fields and methods
+ *   fields      FieldRecord
+ *   methods     MethodRecord, owning a contiguous run of args
+ *   args        ArgRecord
+ *   index       IndexSlot[indexSlots], open addressing on Hash("Namespace.Class")
+ */
+namespace UnityMetadata {
+	constexpr char          kMagic[4] = { 'U', 'R', 'M', 'D' };
+	constexpr std::uint32_t kVersion  = 1;
+	constexpr std::uint32_t kNone     = 0xffffffffu; // missing type / arg
+
+	enum class Section : std::uint32_t { Strings, Types, Assemblies, Classes, Fields, Methods, Args, Index, Count };
+
+	struct SectionRef {
+		std::uint64_t offset;
+		std::uint64_t size; // in bytes
+	};
+
+	struct Header {
+		char          magic[4];
+		std::uint32_t version;
+		std::uint32_t pointerSize;  // of the process that wrote the dump
+		std::uint32_t indexSlots;   // power of two
+		SectionRef    sections[static_cast<size_t>(Section::Count)];
+	};
+
+	struct TypeRecord {
+		std::uint32_t name;
+		std::int32_t  size;
+	};
+
+	struct AssemblyRecord {
+		std::uint32_t name;
+		std::uint32_t file;
+		std::uint32_t firstClass;
+		std::uint32_t classCount;
+	};
+
+	struct ClassRecord {
+		std::uint32_t name;
+		std::uint32_t namespaze;
+		std::uint32_t parent;
+		std::uint32_t assembly;
+		std::uint32_t firstField;
+		std::uint32_t fieldCount;
+		std::uint32_t firstMethod;
+		std::uint32_t methodCount;
+	};
+
+	enum FieldFlags : std::uint32_t { FieldStatic = 1u << 0 };
+
+	struct FieldRecord {
+		std::uint32_t name;
+		std::uint32_t type;
+		std::int32_t  offset; // -1 for thread static
+		std::uint32_t attrs;  // FieldFlags
+	};
+
+	enum MethodAttrs : std::uint32_t { MethodStatic = 1u << 0, MethodBadPtr = 1u << 1 };
+
+	struct MethodRecord {
+		std::uint32_t name;
+		std::uint32_t returnType;
+		std::uint32_t firstArg;
+		std::uint32_t argCount;
+		std::int32_t  flags;  // METHOD_ATTRIBUTE_*
+		std::uint32_t attrs;  // MethodAttrs
+		std::uint64_t rva;    // relative to the containing image, 0 if unknown
+	};
+
+	struct ArgRecord {
+		std::uint32_t name;
+		std::uint32_t type;
+	};
+
+	struct IndexSlot {
+		std::uint32_t hash;
+		std::uint32_t klass; // class id + 1, 0 marks an empty slot
+	};
+
+	static_assert(sizeof(Header) == 144, "Header layout");
+	static_assert(sizeof(ClassRecord) == 32, "ClassRecord layout");
+	static_assert(sizeof(MethodRecord) == 32, "MethodRecord layout");
+
+	/**
+	 * \brief FNV-1a over the fully-qualified class name, fed in pieces to avoid concatenating
+	 */
+	constexpr auto Hash(std::string_view str, std::uint32_t seed = 2166136261u) -> std::uint32_t {
+		for (const auto c : str) seed = (seed ^ static_cast<unsigned char>(c)) * 16777619u;
+		return seed;
+	}
+
+	constexpr auto HashClass(std::string_view namespaze, std::string_view name) -> std::uint32_t {
+		return namespaze.empty() ? Hash(name) : Hash(name, Hash(".", Hash(namespaze)));
+	}
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MetadataFormat.hpp"
+
+/**
+ * \brief read-only view of a .urmd file written by UnityResolve::DumpToBinary
+ *
+ * Standalone: it only needs MetadataFormat.hpp, so offline tools can use it without the
+ * il2cpp headers. The file is mapped, validated once in Open(), and every lookup afterwards
+ * reads records in place; nothing is parsed or copied up front.
+ */
+class MetadataReader final {
+public:
+	template<typename T>
+	struct Range {
+		const T* first;
+		const T* last;
+
+		[[nodiscard]] auto begin() const -> const T* { return first; }
+		[[nodiscard]] auto end() const -> const T* { return last; }
+		[[nodiscard]] auto size() const -> size_t { return last - first; }
+		[[nodiscard]] auto empty() const -> bool { return first == last; }
+		auto operator[](size_t i) const -> const T& { return first[i]; }
+	};
+
+	MetadataReader() = default;
+
+	explicit MetadataReader(const std::string& path) { Open(path); }
+
+	MetadataReader(const MetadataReader&) = delete;
+	auto operator=(const MetadataReader&) -> MetadataReader& = delete;
+
+	~MetadataReader() { Close(); }
+
+	auto Open(const std::string& path) -> bool {
+		Close();
+		const auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) return false;
+
+		struct stat st {};
+		if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(UnityMetadata::Header)) {
+			size_  = st.st_size;
+			auto p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+			base_  = p == MAP_FAILED ? nullptr : static_cast<const char*>(p);
+		}
+		close(fd);
+
+		if (!base_ || !Validate()) {
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	auto Close() -> void {
+		if (base_) munmap(const_cast<char*>(base_), size_);
+		base_ = nullptr;
+		size_ = 0;
+	}
+
+	[[nodiscard]] auto Ok() const -> bool { return base_ != nullptr; }
+
+	[[nodiscard]] auto Header() const -> const UnityMetadata::Header& { return *reinterpret_cast<const UnityMetadata::Header*>(base_); }
+
+	[[nodiscard]] auto String(std::uint32_t offset) const -> std::string_view {
+		const auto& s = Header().sections[static_cast<size_t>(UnityMetadata::Section::Strings)];
+		if (offset >= s.size) return {};
+		return base_ + s.offset + offset;
+	}
+
+	[[nodiscard]] auto Types() const { return Records<UnityMetadata::TypeRecord>(UnityMetadata::Section::Types); }
+	[[nodiscard]] auto Assemblies() const { return Records<UnityMetadata::AssemblyRecord>(UnityMetadata::Section::Assemblies); }
+	[[nodiscard]] auto Classes() const { return Records<UnityMetadata::ClassRecord>(UnityMetadata::Section::Classes); }
+	[[nodiscard]] auto Fields() const { return Records<UnityMetadata::FieldRecord>(UnityMetadata::Section::Fields); }
+	[[nodiscard]] auto Methods() const { return Records<UnityMetadata::MethodRecord>(UnityMetadata::Section::Methods); }
+	[[nodiscard]] auto Args() const { return Records<UnityMetadata::ArgRecord>(UnityMetadata::Section::Args); }
+
+	[[nodiscard]] auto Classes(const UnityMetadata::AssemblyRecord& assembly) const { return Slice(Classes(), assembly.firstClass, assembly.classCount); }
+	[[nodiscard]] auto Fields(const UnityMetadata::ClassRecord& klass) const { return Slice(Fields(), klass.firstField, klass.fieldCount); }
+	[[nodiscard]] auto Methods(const UnityMetadata::ClassRecord& klass) const { return Slice(Methods(), klass.firstMethod, klass.methodCount); }
+	[[nodiscard]] auto Args(const UnityMetadata::MethodRecord& method) const { return Slice(Args(), method.firstArg, method.argCount); }
+
+	/**
+	 * \brief name of a type id, "" for UnityMetadata::kNone
+	 */
+	[[nodiscard]] auto TypeName(std::uint32_t type) const -> std::string_view {
+		const auto types = Types();
+		return type < types.size() ? String(types[type].name) : std::string_view{};
+	}
+
+	/**
+	 * \brief hash index lookup, e.g. FindClass("UnityEngine", "GameObject")
+	 */
+	[[nodiscard]] auto FindClass(std::string_view namespaze, std::string_view name) const -> const UnityMetadata::ClassRecord* {
+		const auto index   = Records<UnityMetadata::IndexSlot>(UnityMetadata::Section::Index);
+		const auto classes = Classes();
+		const auto hash    = UnityMetadata::HashClass(namespaze, name);
+		const auto mask    = index.size() - 1;
+		for (size_t i = hash & mask, probes = 0; probes < index.size(); i = (i + 1) & mask, probes++) {
+			const auto& slot = index[i];
+			if (slot.klass == 0) return nullptr;
+			if (slot.hash != hash || slot.klass > classes.size()) continue;
+			const auto& klass = classes[slot.klass - 1];
+			if (String(klass.name) == name && String(klass.namespaze) == namespaze) return &klass;
+		}
+		return nullptr;
+	}
+
+	/**
+	 * \brief lookup by "Namespace.Class"; the last '.' separates the namespace
+	 */
+	[[nodiscard]] auto FindClass(std::string_view fullName) const -> const UnityMetadata::ClassRecord* {
+		const auto dot = fullName.rfind('.');
+		if (dot == std::string_view::npos) return FindClass({}, fullName);
+		return FindClass(fullName.substr(0, dot), fullName.substr(dot + 1));
+	}
+
+	[[nodiscard]] auto FindField(const UnityMetadata::ClassRecord& klass, std::string_view name) const -> const UnityMetadata::FieldRecord* {
+		for (const auto& field : Fields(klass))
+			if (String(field.name) == name) return &field;
+		return nullptr;
+	}
+
+	/**
+	 * \brief first method named `name`, with `args` parameters unless args is -1
+	 */
+	[[nodiscard]] auto FindMethod(const UnityMetadata::ClassRecord& klass, std::string_view name, int args = -1) const -> const UnityMetadata::MethodRecord* {
+		for (const auto& method : Methods(klass))
+			if ((args < 0 || method.argCount == static_cast<std::uint32_t>(args)) && String(method.name) == name) return &method;
+		return nullptr;
+	}
+
+private:
+	template<typename T>
+	[[nodiscard]] auto Records(UnityMetadata::Section section) const -> Range<T> {
+		const auto& s     = Header().sections[static_cast<size_t>(section)];
+		const auto  first = reinterpret_cast<const T*>(base_ + s.offset);
+		return { first, first + s.size / sizeof(T) };
+	}
+
+	template<typename T>
+	[[nodiscard]] static auto Slice(Range<T> all, std::uint32_t first, std::uint32_t count) -> Range<T> {
+		if (first > all.size() || count > all.size() - first) return { all.last, all.last };
+		return { all.first + first, all.first + first + count };
+	}
+
+	auto Validate() const -> bool {
+		const auto& header = Header();
+		if (memcmp(header.magic, UnityMetadata::kMagic, sizeof(header.magic)) != 0) return false;
+		if (header.version != UnityMetadata::kVersion) return false;
+		if (header.indexSlots == 0 || (header.indexSlots & (header.indexSlots - 1)) != 0) return false;
+
+		for (const auto& s : header.sections)
+			if (s.offset % 8 != 0 || s.offset > size_ || s.size > size_ - s.offset) return false;
+
+		const auto& strings = header.sections[static_cast<size_t>(UnityMetadata::Section::Strings)];
+		if (strings.size == 0 || base_[strings.offset + strings.size - 1] != '\0') return false;
+
+		const auto& index = header.sections[static_cast<size_t>(UnityMetadata::Section::Index)];
+		return index.size == header.indexSlots * sizeof(UnityMetadata::IndexSlot);
+	}
+
+	const char* base_{ nullptr };
+	size_t      size_{ 0 };
+};
@@ -0,0 +1,431 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * \brief trigram index over a large set of short names, for substring, prefix and regex search
+ *
+ * Names are interned: identical names (ToString, .ctor, m_CachedPtr, ...) are stored and
+ * indexed once and map back to every entry that used them. Each distinct name contributes its
+ * case-folded trigrams to a CSR posting table; a substring query intersects the posting
+ * lists of its trigrams, smallest first, and only verifies the survivors. Prefix queries use
+ * the distinct names sorted case-insensitively. Regex queries prefilter on the longest literal
+ * run of the pattern when it is not inside an alternation.
+ *
+ * Build once with Add()... then Build(); queries are const and safe from any thread.
+ */
+class NameIndex final {
+public:
+	enum class Mode { Substring, Prefix, Regex };
+
+	auto Clear() -> void { *this = NameIndex{}; }
+
+	/**
+	 * \brief add a name, returns its entry id (ids are assigned 0, 1, 2, ... in call order)
+	 */
+	auto Add(std::string_view name) -> std::uint32_t {
+		pending_.push_back(name.empty() ? 0 : Intern(name));
+		return static_cast<std::uint32_t>(pending_.size() - 1);
+	}
+
+	auto Build() -> void {
+		// name -> entries, counting sort; entries of one name stay in insertion order
+		entryStart_.assign(IdEnd() + 1, 0);
+		for (const auto name : pending_) entryStart_[name + 1]++;
+		for (size_t i = 1; i < entryStart_.size(); i++) entryStart_[i] += entryStart_[i - 1];
+		entries_.resize(pending_.size());
+		std::vector<std::uint32_t> fill(entryStart_.begin(), entryStart_.end() - 1);
+		for (std::uint32_t e = 0; e < pending_.size(); e++) entries_[fill[pending_[e]]++] = e;
+		decltype(pending_)().swap(pending_);
+		decltype(interned_)().swap(interned_);
+
+		folded_ = chars_;
+		for (auto& c : folded_) c = static_cast<char>(Fold(c));
+
+		// trigram -> names, counting sort over the 18-bit key space; names are visited in id
+		// order so every posting list comes out sorted
+		std::vector<std::uint32_t> grams, gramStart{ 0, 0 };
+		for (std::uint32_t id = 1; id < IdEnd(); id++) {
+			const auto name  = Name(id);
+			const auto first = grams.size();
+			for (size_t i = 0; i + 3 <= name.size(); i++) grams.push_back(Trigram(name.data() + i));
+			std::sort(grams.begin() + first, grams.end());
+			grams.erase(std::unique(grams.begin() + first, grams.end()), grams.end());
+			gramStart.push_back(static_cast<std::uint32_t>(grams.size()));
+		}
+		postingStart_.assign(kKeys + 1, 0);
+		for (const auto key : grams) postingStart_[key + 1]++;
+		for (size_t k = 1; k <= kKeys; k++) postingStart_[k] += postingStart_[k - 1];
+		postings_.resize(grams.size());
+		fill.assign(postingStart_.begin(), postingStart_.end() - 1);
+		for (std::uint32_t id = 1; id < IdEnd(); id++)
+			for (auto g = gramStart[id]; g < gramStart[id + 1]; g++) postings_[fill[grams[g]]++] = id;
+
+		// id 0 (entries added with an empty name) sorts first and matches an empty prefix
+		sorted_.resize(IdEnd());
+		for (std::uint32_t id = 0; id < IdEnd(); id++) sorted_[id] = id;
+		std::sort(sorted_.begin(), sorted_.end(), [this](std::uint32_t l, std::uint32_t r) { return Folded(l) < Folded(r); });
+	}
+
+	[[nodiscard]] auto Names() const -> size_t { return IdEnd() - 1; }
+
+	[[nodiscard]] auto Entries() const -> size_t { return entries_.size(); }
+
+	/**
+	 * \brief call onMatch(entryId, name) for up to limit entries, returns how many were reported
+	 *
+	 * With ignoreCase, substring and prefix queries compare ASCII case-insensitively; regex
+	 * queries use std::regex::icase. A regex that ValidRegex() rejects reports nothing: under
+	 * -fno-exceptions std::regex aborts the process on a syntax error instead of throwing.
+	 */
+	template<typename F>
+	auto Search(std::string_view query, Mode mode, size_t limit, bool ignoreCase, F&& onMatch) const -> size_t {
+		size_t found = 0;
+		const auto report = [&](std::uint32_t id) {
+			for (auto e = entryStart_[id]; e < entryStart_[id + 1] && found < limit; e++, found++) onMatch(entries_[e], Name(id));
+			return found < limit;
+		};
+
+		std::string folded(query);
+		for (auto& c : folded) c = static_cast<char>(Fold(c));
+
+		if (mode == Mode::Prefix) {
+			auto it = std::lower_bound(sorted_.begin(), sorted_.end(), std::string_view(folded), [this](std::uint32_t id, std::string_view q) { return Folded(id) < q; });
+			for (; it != sorted_.end() && Folded(*it).substr(0, folded.size()) == folded; ++it) {
+				if (!ignoreCase && Name(*it).compare(0, query.size(), query) != 0) continue;
+				if (!report(*it)) break;
+			}
+			return found;
+		}
+
+		if (mode == Mode::Substring) {
+			ForCandidates(query, [&](std::uint32_t id) {
+				const auto hit = ignoreCase ? Folded(id).find(folded) != std::string_view::npos : Name(id).find(query) != std::string_view::npos;
+				return !hit || report(id);
+			});
+			return found;
+		}
+
+		if (!ValidRegex(query)) return 0;
+		auto flags = std::regex::ECMAScript | std::regex::optimize;
+		if (ignoreCase) flags |= std::regex::icase;
+#if defined(__cpp_exceptions)
+		std::regex re;
+		try {
+			re.assign(query.begin(), query.end(), flags);
+		} catch (const std::regex_error&) {
+			return 0;
+		}
+#else
+		const std::regex re(query.begin(), query.end(), flags);
+#endif
+		ForCandidates(RequiredLiteral(query), [&](std::uint32_t id) {
+			const auto name = Name(id);
+			return !std::regex_search(name.begin(), name.end(), re) || report(id);
+		});
+		return found;
+	}
+
+	/**
+	 * \brief conservative ECMAScript syntax check, run before a pattern reaches std::regex
+	 *
+	 * Accepts literals, '.', classes with ordered literal ranges, groups ((...), (?:...),
+	 * (?=...), (?!...)), alternation, anchors, the quantifiers ? * + {n} {n,} {n,m} with an
+	 * optional lazy '?', and the escapes \d \D \s \S \w \W \b \B \f \n \r \t \v \0 \xHH
+	 * \uHHHH and escaped punctuation. Everything else, backreferences included, is rejected
+	 * even where std::regex would take it.
+	 */
+	static auto ValidRegex(std::string_view pattern) -> bool {
+		const auto escape = [&](size_t i, bool& set) { return EscapeLength(pattern, i, set); };
+
+		std::vector<bool> assertions; // per open group: lookahead, cannot be quantified
+		bool quantifiable = false, quantified = false;
+		for (size_t i = 0; i < pattern.size(); i++) {
+			const auto c = pattern[i];
+			switch (c) {
+				case '(':
+					if (i + 1 < pattern.size() && pattern[i + 1] == '?') {
+						if (i + 2 >= pattern.size() || (pattern[i + 2] != ':' && pattern[i + 2] != '=' && pattern[i + 2] != '!')) return false;
+						assertions.push_back(pattern[i + 2] != ':');
+						i += 2;
+					} else assertions.push_back(false);
+					quantifiable = quantified = false;
+					break;
+				case ')':
+					if (assertions.empty()) return false;
+					quantifiable = !assertions.back();
+					quantified   = false;
+					assertions.pop_back();
+					break;
+				case '|':
+				case '^':
+				case '$': quantifiable = quantified = false; break;
+				case '?':
+				case '*':
+				case '+':
+				case '{': {
+					if (c == '?' && quantified) {
+						// lazy modifier
+						quantified = false;
+						break;
+					}
+					if (!quantifiable) return false;
+					if (c == '{') {
+						const auto close = pattern.find('}', i);
+						if (close == std::string_view::npos) return false;
+						const auto body  = pattern.substr(i + 1, close - i - 1);
+						const auto comma = body.find(',');
+						const auto digits = [](std::string_view d) { return !d.empty() && d.size() <= 9 && std::all_of(d.begin(), d.end(), [](char x) { return isdigit(static_cast<unsigned char>(x)) != 0; }); };
+						const auto low = body.substr(0, comma);
+						if (!digits(low)) return false;
+						if (comma != std::string_view::npos) {
+							const auto high = body.substr(comma + 1);
+							if (!high.empty() && (!digits(high) || std::stoul(std::string(high)) < std::stoul(std::string(low)))) return false;
+						}
+						i = close;
+					}
+					quantifiable = false;
+					quantified   = true;
+					break;
+				}
+				case '}':
+				case ']': return false;
+				case '[': {
+					auto j = i + 1;
+					if (j < pattern.size() && pattern[j] == '^') j++;
+					// ECMAScript: "[]" is an empty class and "[^]" matches anything
+					for (;;) {
+						if (j >= pattern.size()) return false;
+						if (pattern[j] == ']') break;
+						// [: :] / [= =] / [. .] classes are not supported
+						if (pattern[j] == '[') return false;
+
+						// member: a plain character, or an escape; sets (\d...) cannot start a range
+						int member = static_cast<unsigned char>(pattern[j]);
+						if (pattern[j] == '\\') {
+							bool set;
+							if (escape(j, set) != 2 || pattern[j + 1] == 'B') return false;
+							member = set || isalnum(static_cast<unsigned char>(pattern[j + 1])) ? -1 : static_cast<unsigned char>(pattern[j + 1]);
+							j += 2;
+						} else j++;
+
+						if (j + 1 < pattern.size() && pattern[j] == '-' && pattern[j + 1] != ']') {
+							// range: both ends plain characters, in order
+							const auto hiAt = j + 1;
+							int        hi   = static_cast<unsigned char>(pattern[hiAt]);
+							if (member < 0 || pattern[hiAt] == '[') return false;
+							if (pattern[hiAt] == '\\') {
+								if (hiAt + 1 >= pattern.size() || isalnum(static_cast<unsigned char>(pattern[hiAt + 1]))) return false;
+								hi = static_cast<unsigned char>(pattern[hiAt + 1]);
+								j  = hiAt + 2;
+							} else j = hiAt + 1;
+							if (hi < member) return false;
+						}
+					}
+					i            = j;
+					quantifiable = true;
+					quantified   = false;
+					break;
+				}
+				case '\\': {
+					bool set;
+					const auto len = escape(i, set);
+					if (!len) return false;
+					quantifiable = pattern[i + 1] != 'b' && pattern[i + 1] != 'B';
+					quantified   = false;
+					i += len - 1;
+					break;
+				}
+				default:
+					quantifiable = true;
+					quantified   = false;
+					break;
+			}
+		}
+		return assertions.empty();
+	}
+
+private:
+	/**
+	 * \brief length of the escape at pattern[i] == '\\', 0 if ValidRegex does not support it
+	 *
+	 * set tells \d \s \w and their negations apart from escapes of a single character.
+	 */
+	static auto EscapeLength(std::string_view pattern, size_t i, bool& set) -> size_t {
+		const auto hex = [&](size_t at, size_t count) {
+			if (at + count > pattern.size()) return false;
+			for (size_t k = at; k < at + count; k++)
+				if (!isxdigit(static_cast<unsigned char>(pattern[k]))) return false;
+			return true;
+		};
+
+		set = false;
+		if (i + 1 >= pattern.size()) return 0;
+		const auto c = pattern[i + 1];
+		if (!isalnum(static_cast<unsigned char>(c))) return 2;
+		switch (c) {
+			case 'd': case 'D': case 's': case 'S': case 'w': case 'W': set = true; return 2;
+			case 'b': case 'B': case 'f': case 'n': case 'r': case 't': case 'v': return 2;
+			case '0': return i + 2 < pattern.size() && isdigit(static_cast<unsigned char>(pattern[i + 2])) ? 0 : 2;
+			case 'x': return hex(i + 2, 2) ? 4 : 0;
+			case 'u': return hex(i + 2, 4) ? 6 : 0;
+			default: return 0;
+		}
+	}
+
+	static auto Fold(char c) -> unsigned char { return static_cast<unsigned char>(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c); }
+
+	static constexpr std::uint32_t kKeys = 1u << 18;
+
+	// 6 bits per character: letters (case-folded), digits and '_' get their own code, the rest
+	// share the remaining ones; collisions only widen the candidate set, matches are verified
+	static auto Code(char c) -> std::uint32_t {
+		const auto f = Fold(c);
+		if (f >= 'a' && f <= 'z') return f - 'a';
+		if (f >= '0' && f <= '9') return 26 + (f - '0');
+		if (f == '_') return 36;
+		return 37 + f % 27;
+	}
+
+	static auto Trigram(const char* p) -> std::uint32_t { return Code(p[0]) << 12 | Code(p[1]) << 6 | Code(p[2]); }
+
+	/**
+	 * \brief longest literal run every match must contain, empty if none can be proven
+	 *
+	 * Only runs outside groups are considered; a top-level alternation proves nothing.
+	 */
+	static auto RequiredLiteral(std::string_view pattern) -> std::string {
+		std::string best, run;
+		int         depth = 0;
+		const auto  cut   = [&] {
+			if (depth == 0 && run.size() > best.size()) best = run;
+			run.clear();
+		};
+		for (size_t i = 0; i < pattern.size(); i++) {
+			const auto c = pattern[i];
+			switch (c) {
+				case '|':
+					if (depth == 0) return {};
+					cut();
+					break;
+				case '(':
+					cut();
+					depth++;
+					break;
+				case ')':
+					cut();
+					depth = std::max(depth - 1, 0);
+					break;
+				case '?':
+				case '*':
+				case '{':
+					// the previous atom is optional
+					if (!run.empty()) run.pop_back();
+					cut();
+					if (c == '{') i = std::min(pattern.find('}', i), pattern.size());
+					break;
+				case '[': {
+					cut();
+					// skip the class; in ECMAScript "]" right after "[" or "[^" closes it
+					auto j = i + 1;
+					if (j < pattern.size() && pattern[j] == '^') j++;
+					while (j < pattern.size() && pattern[j] != ']') j += pattern[j] == '\\' ? 2 : 1;
+					i = j;
+					break;
+				}
+				case '\\':
+					if (i + 1 < pattern.size() && !isalnum(static_cast<unsigned char>(pattern[i + 1]))) run += pattern[++i];
+					else {
+						// \d, \xHH, \uHHHH...: skip all of it, its hex digits are not literal
+						bool set;
+						cut();
+						i += std::max<size_t>(EscapeLength(pattern, i, set), 2) - 1;
+					}
+					break;
+				case '+':
+				case '.':
+				case '^':
+				case '$': cut(); break;
+				default: run += c; break;
+			}
+		}
+		cut();
+		return best;
+	}
+
+	/**
+	 * \brief visit every name that contains all trigrams of literal; all names, the empty one
+	 * included, if it has none
+	 */
+	template<typename F>
+	auto ForCandidates(std::string_view literal, F&& visit) const -> void {
+		if (literal.size() < 3) {
+			for (std::uint32_t id = 0; id < IdEnd(); id++)
+				if (!visit(id)) return;
+			return;
+		}
+
+		std::vector<std::pair<const std::uint32_t*, const std::uint32_t*>> lists;
+		for (size_t i = 0; i + 3 <= literal.size(); i++) {
+			const auto key = Trigram(literal.data() + i);
+			if (postingStart_[key] == postingStart_[key + 1]) return;
+			lists.emplace_back(postings_.data() + postingStart_[key], postings_.data() + postingStart_[key + 1]);
+		}
+		std::sort(lists.begin(), lists.end(), [](const auto& l, const auto& r) { return l.second - l.first < r.second - r.first; });
+
+		for (auto p = lists[0].first; p != lists[0].second; ++p) {
+			auto inAll = true;
+			for (size_t l = 1; l < lists.size() && inAll; l++) inAll = std::binary_search(lists[l].first, lists[l].second, *p);
+			if (inAll && !visit(*p)) return;
+		}
+	}
+
+	auto Intern(std::string_view name) -> std::uint32_t {
+		if (IdEnd() * 2 >= interned_.size()) Rehash(std::max<size_t>(interned_.size() * 2, 1024));
+
+		const auto mask = interned_.size() - 1;
+		auto       i    = std::hash<std::string_view>{}(name) & mask;
+		for (; interned_[i]; i = (i + 1) & mask)
+			if (Name(interned_[i]) == name) return interned_[i];
+
+		const auto id = IdEnd();
+		chars_.append(name.data(), name.size());
+		nameStart_.push_back(static_cast<std::uint32_t>(chars_.size()));
+		interned_[i] = id;
+		return id;
+	}
+
+	auto Rehash(size_t slots) -> void {
+		std::vector<std::uint32_t> table(slots, 0);
+		for (std::uint32_t id = 1; id < IdEnd(); id++) {
+			auto i = std::hash<std::string_view>{}(Name(id)) & (slots - 1);
+			while (table[i]) i = (i + 1) & (slots - 1);
+			table[i] = id;
+		}
+		interned_.swap(table);
+	}
+
+	// one past the largest name id
+	[[nodiscard]] auto IdEnd() const -> std::uint32_t { return static_cast<std::uint32_t>(nameStart_.size() - 1); }
+
+	[[nodiscard]] auto Name(std::uint32_t id) const -> std::string_view { return std::string_view(chars_).substr(nameStart_[id], nameStart_[id + 1] - nameStart_[id]); }
+
+	[[nodiscard]] auto Folded(std::uint32_t id) const -> std::string_view { return std::string_view(folded_).substr(nameStart_[id], nameStart_[id + 1] - nameStart_[id]); }
+
+	std::string                                          chars_;
+	std::string                                          folded_;        // chars_ in lower case
+	std::vector<std::uint32_t>                           nameStart_{ 0, 0 }; // id 0 is ""
+	std::vector<std::uint32_t>                           interned_;     // open addressing over name ids until Build()
+	std::vector<std::uint32_t>                           pending_;       // entry -> name until Build()
+	std::vector<std::uint32_t>                           entryStart_;    // name -> entries_ range
+	std::vector<std::uint32_t>                           entries_;
+	std::vector<std::uint32_t>                           postingStart_;  // trigram key -> postings_ range
+	std::vector<std::uint32_t>                           postings_;      // sorted name ids per key
+	std::vector<std::uint32_t>                           sorted_;        // name ids, 0 included, by case-folded name
+};
@@ -5,6 +5,9 @@
 std::unordered_map<std::string, void*> UnityResolve::address_ = {};
 Il2CppDomain* UnityResolve::pDomain_=nullptr;
 Il2CppThread* UnityResolve::pThread_=nullptr;
+UnityResolve::ThreadAttachStats UnityResolve::attachStats_;
+UnityResolve::MethodIndex UnityResolve::methodIndex_;
+UnityResolve::NameSearch UnityResolve::nameSearch_;
 std::vector<UnityResolve::Assembly*> UnityResolve::assembly_;
 
 void listAllGameObjects()
@@ -11,11 +11,17 @@
 #include <sstream>
 #include <iostream>
 #include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <algorithm>
+#include <cstdarg>
+#include <atomic>
 #include <iomanip>
 #include <string>
 #include <unordered_map>
 #include <functional>
 #include <vector>
+#include <type_traits>
 #include <limits.h>
 #include <codecvt>
 #include <locale>
@@ -33,6 +39,10 @@
 #include "utils.h"
 
 #include "json.hpp"
+#include "BufferedWriter.hpp"
+#include "MetadataFormat.hpp"
+#include "NameIndex.hpp"
+#include "StartupProfiler.hpp"
 #include <bitset>
 
 
@@ -66,6 +76,20 @@ struct UnityResolve final {
             return j;
         };
 
+        // keys are emitted in nlohmann::json's (sorted) order so the output matches to_json().dump()
+        auto write_json(BufferedWriter& out) const -> void {
+            out.Write("{\"classes\":[");
+            for (size_t i = 0; i < classes.size(); i++) {
+                if (i) out.Put(',');
+                classes[i]->write_json(out);
+            }
+            out.Write("],\"file\":");
+            WriteJsonString(out, file);
+            out.Write(",\"name\":");
+            WriteJsonString(out, name);
+            out.Put('}');
+        }
+
 
 		[[nodiscard]] auto Get(const std::string& strClass, const std::string& strNamespace = "*", const std::string& strParent = "*") const -> Class* {
 			for (const auto pClass : classes) if (strClass == pClass->name && (strNamespace == "*" || pClass->namespaze == strNamespace) && (strParent == "*" || pClass->parent == strParent)) return pClass;
@@ -86,6 +110,12 @@ struct UnityResolve final {
             return j;
         };
 
+        auto write_json(BufferedWriter& out) const -> void {
+            out.Write("{\"name\":");
+            WriteJsonString(out, name);
+            out.Format(",\"size\":%d}", size);
+        }
+
 
 		[[nodiscard]] auto GetObject() const -> void* {
             return il2cpp_type_get_object( address);
@@ -125,6 +155,26 @@ struct UnityResolve final {
             return j;
         };
 
+        auto write_json(BufferedWriter& out) const -> void {
+            out.Write("{\"fields\":[");
+            for (size_t i = 0; i < fields.size(); i++) {
+                if (i) out.Put(',');
+                fields[i]->write_json(out);
+            }
+            out.Write("],\"methods\":[");
+            for (size_t i = 0; i < methods.size(); i++) {
+                if (i) out.Put(',');
+                methods[i]->write_json(out);
+            }
+            out.Write("],\"name\":");
+            WriteJsonString(out, name);
+            out.Write(",\"namespace\":");
+            WriteJsonString(out, namespaze);
+            out.Write(",\"parent\":");
+            WriteJsonString(out, parent);
+            out.Put('}');
+        }
+
 
 		template <typename RType>
 		auto Get(const std::string& name, const std::vector<std::string>& args = {}) -> RType* {
@@ -265,6 +315,14 @@ struct UnityResolve final {
             return j;
         };
 
+        auto write_json(BufferedWriter& out) const -> void {
+            out.Write("{\"name\":");
+            WriteJsonString(out, name);
+            out.Format(",\"offset\":%d,\"static_field\":%s,\"type\":", offset, static_field ? "true" : "false");
+            type->write_json(out);
+            out.Put('}');
+        }
+
 
 		template <typename T>
 		auto SetValue(T* value) const -> void {
@@ -329,6 +387,31 @@ struct UnityResolve final {
             return j;
         };
 
+        auto write_json(BufferedWriter& out) const -> void {
+            out.Write("{\"args\":[");
+            for (size_t i = 0; i < args.size(); i++) {
+                if (i) out.Put(',');
+                const Arg* arg = args[i];
+                if (arg == nullptr) {
+                    out.Write("null");
+                    continue;
+                }
+                out.Write("{\"name\":");
+                WriteJsonString(out, arg->name);
+                out.Write(",\"type\":");
+                if (arg->pType) arg->pType->write_json(out);
+                else out.Write("null");
+                out.Put('}');
+            }
+            out.Format("],\"badPtr\":%s,\"flags\":%d,\"function\":%llu,\"name\":",
+                       badPtr ? "true" : "false", flags,
+                       static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(function)));
+            WriteJsonString(out, name);
+            out.Write(",\"return_type\":");
+            return_type->write_json(out);
+            out.Format(",\"static_function\":%s}", static_function ? "true" : "false");
+        }
+
 		template <typename Return, typename... Args>
 		auto Invoke(Args... args) -> Return {
 			if (function) return reinterpret_cast<Return(UNITY_CALLING_CONVENTION*)(Args...)>(function)(args...);
@@ -402,727 +485,762 @@ struct UnityResolve final {
 
 	};
 
-	static auto ThreadAttach() -> void {
-		il2cpp_thread_attach( pDomain_);
+	struct ThreadAttachStats final {
+		std::atomic<std::uint64_t> attached{ 0 };  // il2cpp_thread_attach calls
+		std::atomic<std::uint64_t> adopted{ 0 };   // thread was already attached by someone else
+		std::atomic<std::uint64_t> reused{ 0 };    // served from the thread-local attachment
+		std::atomic<std::uint64_t> detached{ 0 };  // il2cpp_thread_detach calls
+	};
+
+	/**
+	 * \brief per-thread il2cpp attachment, created on first use and released when the thread exits
+	 */
+	struct ThreadAttachment final {
+		Il2CppThread* thread{ nullptr };
+		bool          owned{ false };    // only detach what we attached ourselves
+
+		auto Release() -> void {
+			if (owned && thread) {
+				il2cpp_thread_detach(thread);
+				attachStats_.detached.fetch_add(1, std::memory_order_relaxed);
+			}
+			thread = nullptr;
+			owned  = false;
+		}
+
+		~ThreadAttachment() { Release(); }
+	};
+
+	static auto CurrentAttachment() -> ThreadAttachment& {
+		thread_local ThreadAttachment attachment;
+		return attachment;
+	}
+
+	static auto ThreadAttach() -> Il2CppThread* {
+		auto& attachment = CurrentAttachment();
+		if (attachment.thread) {
+			attachStats_.reused.fetch_add(1, std::memory_order_relaxed);
+			return attachment.thread;
+		}
+
+		if ((attachment.thread = il2cpp_thread_current())) {
+			attachStats_.adopted.fetch_add(1, std::memory_order_relaxed);
+			return attachment.thread;
+		}
+
+		attachment.thread = il2cpp_thread_attach( pDomain_ ? pDomain_ : il2cpp_domain_get());
+		attachment.owned  = attachment.thread != nullptr;
+		attachStats_.attached.fetch_add(1, std::memory_order_relaxed);
+		return attachment.thread;
 	}
 
 	static auto ThreadDetach() -> void {
-        if(pThread_) il2cpp_thread_detach( pThread_); // pThread
-        pThread_ = nullptr;
+		auto& attachment = CurrentAttachment();
+		if (attachment.thread && attachment.thread == pThread_) pThread_ = nullptr;
+		attachment.Release();
+	}
+
+	static auto GetThreadAttachStats() -> const ThreadAttachStats& {
+		return attachStats_;
 	}
 
 	static auto Init() -> void {
+		StartupProfiler::Scope profile("UnityResolve::Init");
         pDomain_ = il2cpp_domain_get();
-        pThread_ = il2cpp_thread_attach( pDomain_);
+        {
+            StartupProfiler::Scope profileAttach("UnityResolve::Init", "ThreadAttach");
+            pThread_ = ThreadAttach();
+        }
         ForeachAssembly();
 	}
 
-	static auto DumpToJson() -> nlohmann::json {
-        nlohmann::json j_array = nlohmann::json::array();
-        for (const auto& pAssembly : assembly_) {
-            j_array.push_back(pAssembly->to_json());
-        }
-        return j_array;
-    }
-
-	static auto DumpToCFile(const std::string& path) -> void {
-		std::string csDumpPath = path+"dump.cs";
-        std::ofstream io(csDumpPath, std::fstream::out);
-        if (!io) return;
-    
-        for (const auto& pAssembly : assembly_) {
-            for (const auto& pClass : pAssembly->classes) {
-                io << "\tnamespace: ";
-                if (!pClass->namespaze.empty()) {
-                    io << pClass->namespaze;
-                }
-                io << "\n";
-    
-                io << "\tAssembly: ";
-                if (!pAssembly->name.empty()) {
-                    io << pAssembly->name;
-                }
-                io << "\n";
-    
-                io << "\tAssemblyFile: ";
-                if (!pAssembly->file.empty()) {
-                    io << pAssembly->file;
-                }
-                io << "\n";
-    
-                io << "\tclass " << pClass->name;
-                if (!pClass->parent.empty()) {
-                    io << " : " << pClass->parent;
-                }
-                io << " {\n\n";
-    
-                for (const auto& pField : pClass->fields) {
-                    io << "\t\t";
-                    io << std::hex << std::showpos << std::internal << std::setfill('0');
-                    io << std::setw(8) << pField->offset << " | ";
-    
-                    if (pField->static_field) {
-                        io << "static ";
-                    }
-    
-                    io << pField->type->name << " " << pField->name << ";\n";
-                }
-                io << "\n";
-    
-                for (const auto& pMethod : pClass->methods) {
-                    io << "\t\t[Flags: ";
-                    io << std::bitset<32>(pMethod->flags) << "] ";
-                    io << "[ParamsCount: ";
-                    io << std::setw(4) << std::dec << pMethod->args.size() << "] ";
-                    io << "|RVA: ";
-                    {
-                        //io << std::showpos << std::internal << std::setfill('0');
-                        std::string RVA = get_module_name_and_offset(pMethod->function);
-                        io <<  RVA;
-                    }
-                    io << "|\n";
-    
-                    io << "\t\t";
-                    if (pMethod->static_function) {
-                        io << "static ";
-                    }
-                    io << pMethod->return_type->name << " " << pMethod->name << "(";
-    
-                    std::string params;
-                    for (const auto& pArg : pMethod->args) {
-                        params += pArg->pType->name + " " + pArg->name + ", ";
-                    }
-                    if (!params.empty()) {
-                        params.pop_back();
-                        params.pop_back();
-                    }
-                    io << params;
-    
-                    io << ");\n\n";
-                }
-    
-                io << "\t}\n\n";
-            }
-        }
-    
-        io << '\n';
-        io.close();
+	/**
+	 * \brief sorted start addresses of every collected Method::function, for symbolizing PCs
+	 *
+	 * Method sizes are not known, so a method is taken to extend to the next start address,
+	 * the end of its loaded segment, or maxMethodSize, whichever comes first. Starts live in
+	 * their own array so the binary search only touches the address column.
+	 */
+	struct MethodIndex final {
+		std::vector<std::uintptr_t> starts;
+		std::vector<std::uintptr_t> ends;
+		std::vector<const Method*>  methods;
+	};
 
-		LOG_INFOS("go here");
-    
-        std::ofstream io2(path + "struct.hpp", std::fstream::out);
-        if (!io2) return;
-    
-        for (const auto& pAssembly : assembly_) {
-            for (const auto& pClass : pAssembly->classes) {
-                io2 << "\tnamespace: ";
-                if (!pClass->namespaze.empty()) {
-                    io2 << pClass->namespaze;
-                }
-                io2 << "\n";
-    
-                io2 << "\tAssembly: ";
-                if (!pAssembly->name.empty()) {
-                    io2 << pAssembly->name;
-                }
-                io2 << "\n";
-    
-                io2 << "\tAssemblyFile: ";
-                if (!pAssembly->file.empty()) {
-                    io2 << pAssembly->file;
-                }
-                io2 << "\n";
-    
-                io2 << "\tstruct " << pClass->name;
-                if (!pClass->parent.empty()) {
-                    io2 << " : " << pClass->parent;
-                }
-                io2 << " {\n\n";
-    
-                for (size_t i = 0; i < pClass->fields.size(); i++) {
-                    if (pClass->fields[i]->static_field) {
-                        continue;
-                    }
-    
-                    auto field = pClass->fields[i];
-    
-                next:
-                    if ((i + 1) >= pClass->fields.size()) {
-                        io2 << "\t\tchar " << field->name << "[0x" << std::hex << std::setw(6) << 4 << "];\n";
-                        continue;
-                    }
-    
-                    if (pClass->fields[i + 1]->static_field) {
-                        i++;
-                        goto next;
-                    }
-    
-                    std::string name = field->name;
-                    std::replace(name.begin(), name.end(), '<', '_');
-                    std::replace(name.begin(), name.end(), '>', '_');
-    
-                    if (field->type->name == "System.Int64") {
-                        io2 << "\t\tstd::int64_t " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 8) {
-                            io2 << "\t\tchar " << name << "_[0x" << std::hex << std::setw(6) << pClass->fields[i + 1]->offset - field->offset - 8 << "];\n";
-                        }
-                        continue;
-                    }
-    
-                    if (field->type->name == "System.UInt64") {
-                        io2 << "\t\tstd::uint64_t " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 8) {
-                            io2 << "\t\tchar " << name << "_[0x" << std::hex << std::setw(6) << pClass->fields[i + 1]->offset - field->offset - 8 << "];\n";
-                        }
-                        continue;
-                    }
-    
-                    if (field->type->name == "System.Int32") {
-                        io2 << "\t\tint " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 4) {
-                            io2 << "\t\tchar " << name << "_[0x" << std::hex << std::setw(6) << pClass->fields[i + 1]->offset - field->offset - 4 << "];\n";
-                        }
-                        continue;
-                    }
-    
-                    if (field->type->name == "System.UInt32") {
-                        io2 << "\t\tstd::uint32_t " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 4) {
-                            io2 << "\t\tchar " << name << "_[0x" << std::hex << std::setw(6) << pClass->fields[i + 1]->offset - field->offset - 4 << "];\n";
-                        }
-                        continue;
-                    }
+	/**
+	 * \brief (re)build the index from the methods ForeachMethod collected; call after Init
+	 *
+	 * Inherited methods are collected once per derived class, so for a shared function the
+	 * entry of the declaring class wins. Not safe to call while other threads look up PCs.
+	 */
+	static auto BuildMethodIndex(const std::uintptr_t maxMethodSize = 0x10000) -> size_t {
+		std::vector<std::pair<std::uintptr_t, const Method*>> entries;
+		for (const auto pAssembly : assembly_)
+			for (const auto pClass : pAssembly->classes)
+				for (const auto pMethod : pClass->methods)
+					if (pMethod->function && !pMethod->badPtr) entries.emplace_back(reinterpret_cast<std::uintptr_t>(pMethod->function), pMethod);
+
+		const auto declared = [](const Method* pMethod) {
+			return pMethod->address && pMethod->klass->classinfo && il2cpp_method_get_class(pMethod->address) == pMethod->klass->classinfo;
+		};
+		std::stable_sort(entries.begin(), entries.end(), [](const auto& l, const auto& r) { return l.first < r.first; });
+
+		auto& index = methodIndex_;
+		index.starts.clear();
+		index.ends.clear();
+		index.methods.clear();
+		for (const auto& entry : entries) {
+			if (!index.starts.empty() && index.starts.back() == entry.first) {
+				if (!declared(index.methods.back()) && declared(entry.second)) index.methods.back() = entry.second;
+				continue;
+			}
+			index.starts.push_back(entry.first);
+			index.methods.push_back(entry.second);
+		}
 
-                    if (field->type->name == "System.Boolean") {
-                        io2 << "\t\tbool " << name << ";\n";
+		// native code after the last method of a segment is not attributed to it
+		std::uintptr_t segmentStart = 0, segmentEnd = 0;
+		index.ends.resize(index.starts.size());
+		for (size_t i = 0; i < index.starts.size(); i++) {
+			const auto start = index.starts[i];
+			if (start < segmentStart || start >= segmentEnd)
+				if (!find_module_segment(reinterpret_cast<void*>(start), &segmentStart, &segmentEnd)) segmentStart = segmentEnd = 0;
+
+			auto end = start + maxMethodSize < start ? UINTPTR_MAX : start + maxMethodSize;
+			if (i + 1 < index.starts.size()) end = std::min(end, index.starts[i + 1]);
+			if (segmentEnd > start) end = std::min(end, segmentEnd);
+			index.ends[i] = end;
+		}
+		return index.starts.size();
+	}
 
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 1) {
-                            std::stringstream hexPadding;
-                            hexPadding << std::hex << std::uppercase << std::setfill('0') << std::setw(6) << (pClass->fields[i + 1]->offset - field->offset - 1);
-                            io2 << "\t\tchar " << name << "_[0x" << hexPadding.str() << "];\n";
-                        }
+	/**
+	 * \brief method containing pc, or nullptr; offset receives pc - Method::function
+	 */
+	static auto MethodAt(const void* pc, std::uintptr_t* offset = nullptr) -> const Method* {
+		const auto& starts  = methodIndex_.starts;
+		const auto  address = reinterpret_cast<std::uintptr_t>(pc);
+		const auto  it      = std::upper_bound(starts.begin(), starts.end(), address);
+		if (it == starts.begin()) return nullptr;
+
+		const auto i = static_cast<size_t>(it - starts.begin()) - 1;
+		if (address >= methodIndex_.ends[i]) return nullptr;
+		if (offset) *offset = address - starts[i];
+		return methodIndex_.methods[i];
+	}
 
-                        continue;
-                    }
+	/**
+	 * \brief format pc as "Namespace.Class::Method+0x1c" into buf, without allocating
+	 *
+	 * A name longer than buf is truncated; false only if pc is in no known method.
+	 */
+	static auto Symbolize(const void* pc, char* buf, const size_t len) -> bool {
+		std::uintptr_t offset = 0;
+		const auto     pMethod = MethodAt(pc, &offset);
+		if (!pMethod || !len) return false;
+
+		const auto& klass = *pMethod->klass;
+		return snprintf(buf, len, "%s%s%s::%s+0x%jx", klass.namespaze.c_str(), klass.namespaze.empty() ? "" : ".", klass.name.c_str(), pMethod->name.c_str(), static_cast<uintmax_t>(offset)) > 0;
+	}
 
-                    if (field->type->name == "System.String") {
-                        io2 << "\t\tUnityResolve::UnityType::String* " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            io2 << "\t\tchar " << name << "_[0x" << std::hex << std::uppercase << std::setfill('0') << std::setw(6) << (pClass->fields[i + 1]->offset - field->offset - sizeof(void*)) << "];\n";
-                        }
-                        continue;
-                    }
+	static auto Symbolize(const void* pc) -> std::string {
+		char buf[512];
+		return Symbolize(pc, buf, sizeof(buf)) ? buf : std::string{};
+	}
 
-                    if (field->type->name == "System.Single") {
-                        io2 << "\t\tfloat " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 4) {
-                            io2 << "\t\tchar " << name << "_[0x" << std::hex << std::uppercase << std::setfill('0') << std::setw(6) << (pClass->fields[i + 1]->offset - field->offset - 4) << "];\n";
-                        }
-                        continue;
-                    }
+	/**
+	 * \brief one hit of SearchNames(); field/method are null for class hits
+	 */
+	struct NameMatch final {
+		enum class Kind { Class, Field, Method };
 
-                    if (field->type->name == "System.Double") {
-                        io2 << "\t\tdouble " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 8) {
-                            io2 << "\t\tchar " << name << "_[0x" << std::hex << std::uppercase << std::setfill('0') << std::setw(6) << (pClass->fields[i + 1]->offset - field->offset - 8) << "];\n";
-                        }
-                        continue;
-                    }
+		Kind    kind;
+		Class*  klass;
+		Field*  field;
+		Method* method;
+	};
 
-                    if (field->type->name == "UnityEngine.Vector3") {
-                        io2 << "\t\tUnityResolve::UnityType::Vector3 " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Vector3)) {
-                            std::stringstream buffer;
-                            buffer << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Vector3));
-                            io2 << "\t\tchar " << name << "_[0x" << buffer.str() << "];\n";
-                        }
-                        continue;
-                    }
+	struct NameSearch final {
+		NameIndex              index;
+		std::vector<NameMatch> matches; // by NameIndex entry id
+	};
 
-                    if (field->type->name == "UnityEngine.Vector2") {
-                        io2 << "\t\tUnityResolve::UnityType::Vector2 " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Vector2)) {
-                            std::stringstream buffer;
-                            buffer << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Vector2));
-                            io2 << "\t\tchar " << name << "_[0x" << buffer.str() << "];\n";
-                        }
-                        continue;
-                    }
+	/**
+	 * \brief index every class, field and method name of the model; call after Init
+	 *
+	 * Not safe to call while other threads search.
+	 */
+	static auto BuildNameIndex() -> size_t {
+		nameSearch_.index.Clear();
+		nameSearch_.matches.clear();
+		const auto add = [](std::string_view name, const NameMatch& match) {
+			nameSearch_.index.Add(name);
+			nameSearch_.matches.push_back(match);
+		};
+		for (const auto pAssembly : assembly_)
+			for (const auto pClass : pAssembly->classes) {
+				add(pClass->name, { NameMatch::Kind::Class, pClass, nullptr, nullptr });
+				for (const auto pField : pClass->fields) add(pField->name, { NameMatch::Kind::Field, pClass, pField, nullptr });
+				for (const auto pMethod : pClass->methods) add(pMethod->name, { NameMatch::Kind::Method, pClass, nullptr, pMethod });
+			}
+		nameSearch_.index.Build();
+		return nameSearch_.matches.size();
+	}
 
-                    if (field->type->name == "UnityEngine.Vector4") {
-                        io2 << "\t\tUnityResolve::UnityType::Vector4 " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Vector4)) {
-                            std::stringstream buffer;
-                            buffer << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Vector4));
-                            io2 << "\t\tchar " << name << "_[0x" << buffer.str() << "];\n";
-                        }
-                        continue;
-                    }
+	/**
+	 * \brief substring / prefix / regex search over the names indexed by BuildNameIndex
+	 */
+	static auto SearchNames(std::string_view query, const NameIndex::Mode mode = NameIndex::Mode::Substring, const size_t limit = 100, const bool ignoreCase = true) -> std::vector<NameMatch> {
+		std::vector<NameMatch> result;
+		nameSearch_.index.Search(query, mode, limit, ignoreCase, [&](std::uint32_t entry, std::string_view) { result.push_back(nameSearch_.matches[entry]); });
+		return result;
+	}
 
-                    if (field->type->name == "UnityEngine.GameObject") {
-                        io2 << "\t\tUnityResolve::UnityType::GameObject* " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            io2 << "\t\tchar " << name << "_[0x"
-                                << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(void*)) << "];\n";
-                        }
-                        continue;
-                    }
+	static auto DumpToJson() -> nlohmann::json {
+        nlohmann::json j_array = nlohmann::json::array();
+        for (const auto& pAssembly : assembly_) {
+            j_array.push_back(pAssembly->to_json());
+        }
+        return j_array;
+    }
 
-                    if (field->type->name == "UnityEngine.Transform") {
-                        io2 << "\t\tUnityResolve::UnityType::Transform* " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            io2 << "\t\tchar " << name << "_[0x"
-                                << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(void*)) << "];\n";
-                        }
-                        continue;
-                    }
+	/**
+	 * \brief stream the DumpToJson() document to a file without building the DOM
+	 *
+	 * Output is byte-identical to DumpToJson().dump(), except that strings which are not
+	 * valid UTF-8 are written through as-is instead of making the whole dump throw.
+	 */
+	static auto DumpToJson(const std::string& path) -> bool {
+		BufferedWriter out(path);
+		return WriteJson(out);
+	}
 
-                    if (field->type->name == "UnityEngine.Animator") {
-                        io2 << "\t\tUnityResolve::UnityType::Animator* " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            io2 << "\t\tchar " << name << "_[0x"
-                                << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(void*)) << "];\n";
-                        }
-                        continue;
-                    }
+	static auto DumpToJson(int fd) -> bool {
+		BufferedWriter out(fd);
+		return WriteJson(out);
+	}
 
-                    if (field->type->name == "UnityEngine.Physics") {
-                        io2 << "\t\tUnityResolve::UnityType::Physics* " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            io2 << "\t\tchar " << name << "_[0x"
-                                << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(void*)) << "];\n";
-                        }
-                        continue;
-                    }
+	static auto WriteJson(BufferedWriter& out) -> bool {
+		out.Put('[');
+		for (size_t i = 0; i < assembly_.size(); i++) {
+			if (i) out.Put(',');
+			assembly_[i]->write_json(out);
+		}
+		out.Put(']');
+		return out.Flush();
+	}
 
-                    if (field->type->name == "UnityEngine.Component") {
-                        io2 << "\t\tUnityResolve::UnityType::Component* " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            io2 << "\t\tchar " << name << "_[0x"
-                                << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(void*)) << "];\n";
-                        }
-                        continue;
-                    }
+	// same escaping rules as nlohmann::json::dump() with ensure_ascii = false
+	static auto WriteJsonString(BufferedWriter& out, const std::string& str) -> void {
+		out.Put('"');
+		const char* run = str.data();
+		const char* end = str.data() + str.size();
+		for (const char* p = run; p != end; p++) {
+			const auto c = static_cast<unsigned char>(*p);
+			if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+			out.Write(run, p - run);
+			run = p + 1;
+			switch (c) {
+				case '"':  out.Write("\\\"", 2); break;
+				case '\\': out.Write("\\\\", 2); break;
+				case '\b': out.Write("\\b", 2); break;
+				case '\f': out.Write("\\f", 2); break;
+				case '\n': out.Write("\\n", 2); break;
+				case '\r': out.Write("\\r", 2); break;
+				case '\t': out.Write("\\t", 2); break;
+				default:   out.Format("\\u%04x", c); break;
+			}
+		}
+		out.Write(run, end - run);
+		out.Put('"');
+	}
 
-                    if (field->type->name == "UnityEngine.Rect") {
-                        io2 << "\t\tUnityResolve::UnityType::Rect " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Rect)) {
-                            io2 << "\t\tchar " << name << "_[0x"
-                                << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Rect)) << "];\n";
-                        }
-                        continue;
-                    }
+	/**
+	 * \brief write the model in the binary format described in MetadataFormat.hpp
+	 *
+	 * One walk over the model fills the record tables and the deduplicated string and type
+	 * tables; they are then written back to back. Read the result with MetadataReader.
+	 */
+	static auto DumpToBinary(const std::string& path) -> bool {
+		using namespace UnityMetadata;
+
+		std::string                                      strings(1, '\0');
+		std::unordered_map<std::string, std::uint32_t>   stringIds;
+		const auto intern = [&](const std::string& str) -> std::uint32_t {
+			if (str.empty()) return 0;
+			const auto it = stringIds.find(str);
+			if (it != stringIds.end()) return it->second;
+			const auto offset = static_cast<std::uint32_t>(strings.size());
+			strings.append(str.c_str(), str.size() + 1);
+			stringIds.emplace(str, offset);
+			return offset;
+		};
 
-                    if (field->type->name == "UnityEngine.Quaternion") {
-                        io2 << "\t\tUnityResolve::UnityType::Quaternion " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Quaternion)) {
-                            io2 << "\t\tchar " << name << "_[0x"
-                                << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Quaternion)) << "];\n";
-                        }
-                        continue;
-                    }
+		std::vector<TypeRecord>                          types;
+		std::unordered_map<std::uint64_t, std::uint32_t> typeIds;
+		const auto internType = [&](const Type* pType) -> std::uint32_t {
+			if (!pType) return kNone;
+			const auto name = intern(pType->name);
+			const auto key  = static_cast<std::uint64_t>(name) << 32 | static_cast<std::uint32_t>(pType->size);
+			const auto it   = typeIds.find(key);
+			if (it != typeIds.end()) return it->second;
+			const auto id = static_cast<std::uint32_t>(types.size());
+			types.push_back({ name, pType->size });
+			typeIds.emplace(key, id);
+			return id;
+		};
 
-                    if (field->type->name == "UnityEngine.Color") {
-                        io2 << "\t\tUnityResolve::UnityType::Color " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Color)) {
-                            io2 << "\t\tchar " << name << "_[0x"
-                                << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Color)) << "];\n";
-                        }
-                        continue;
-                    }
+		std::vector<AssemblyRecord> assemblies;
+		std::vector<ClassRecord>    classes;
+		std::vector<FieldRecord>    fields;
+		std::vector<MethodRecord>   methods;
+		std::vector<ArgRecord>      args;
+		std::vector<std::uint32_t>  hashes;
 
-                    if (field->type->name == "UnityEngine.Matrix4x4") {
-                        io2 << "\t\tUnityResolve::UnityType::Matrix4x4 " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Matrix4x4)) {
-                            io2 << "\t\tchar " << name << "_[0x"
-                                << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Matrix4x4)) << "];\n";
-                        }
-                        continue;
-                    }
+		for (const auto pAssembly : assembly_) {
+			assemblies.push_back({ intern(pAssembly->name), intern(pAssembly->file), static_cast<std::uint32_t>(classes.size()), static_cast<std::uint32_t>(pAssembly->classes.size()) });
 
-                    if (field->type->name == "UnityEngine.Rigidbody") {
-                        io2 << "\t\tUnityResolve::UnityType::Rigidbody* " << name << ";\n";
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            io2 << "\t\tchar " << name << "_[0x"
-                                << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(void*)) << "];\n";
-                        }
-                        continue;
-                    }
+			for (const auto pClass : pAssembly->classes) {
+				classes.push_back({ intern(pClass->name), intern(pClass->namespaze), intern(pClass->parent), static_cast<std::uint32_t>(assemblies.size() - 1),
+									static_cast<std::uint32_t>(fields.size()), static_cast<std::uint32_t>(pClass->fields.size()),
+									static_cast<std::uint32_t>(methods.size()), static_cast<std::uint32_t>(pClass->methods.size()) });
+				hashes.push_back(HashClass(pClass->namespaze, pClass->name));
 
-                    io2 << "\t\tchar " << name << "[0x"
-                        << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                        << (pClass->fields[i + 1]->offset - field->offset) << "];\n";
+				for (const auto pField : pClass->fields)
+					fields.push_back({ intern(pField->name), internType(pField->type), pField->offset, pField->static_field ? FieldStatic : 0u });
 
-                }
-    
-                io2 << "\t}\n\n";
-            }
-        }
-    
-        io2 << '\n';
-        io2.close();
-		LOG_INFOS("go here");
-    }
+				for (const auto pMethod : pClass->methods) {
+					// lock-free lookup in the module table, dladdr would take the linker lock per method
+					std::uintptr_t rva = 0;
+					if (pMethod->function && !find_module_and_offset(pMethod->function, nullptr, &rva)) rva = 0;
 
-	static auto DumpToFile(const std::string& path) -> void {
-		std::string csDumpPath = path+"dump.cs";
-		{
-			FILE *fp = fopen(csDumpPath.c_str(), "w");
-			if (!fp) return;
+					methods.push_back({ intern(pMethod->name), internType(pMethod->return_type), static_cast<std::uint32_t>(args.size()), static_cast<std::uint32_t>(pMethod->args.size()),
+										pMethod->flags, (pMethod->static_function ? MethodStatic : 0u) | (pMethod->badPtr ? MethodBadPtr : 0u), rva });
 
-			for (const auto &pAssembly : assembly_)
-			{
-				for (const auto &pClass : pAssembly->classes)
-				{
-					fprintf(fp, "\tnamespace: ");
-					if (!pClass->namespaze.empty())
-					{
-						fprintf(fp, "%s", pClass->namespaze.c_str());
-					}
-					fprintf(fp, "\n");
+					for (const auto pArg : pMethod->args)
+						args.push_back(pArg ? ArgRecord{ intern(pArg->name), internType(pArg->pType) } : ArgRecord{ 0, kNone });
+				}
+			}
+		}
 
-					fprintf(fp, "\tAssembly: ");
-					if (!pAssembly->name.empty())
-					{
-						fprintf(fp, "%s", pAssembly->name.c_str());
-					}
-					fputs("\n", fp);
+		// load factor <= 0.5 keeps probe chains short
+		std::uint32_t slots = 16;
+		while (slots < classes.size() * 2) slots <<= 1;
+		std::vector<IndexSlot> index(slots, IndexSlot{ 0, 0 });
+		for (std::uint32_t id = 0; id < classes.size(); id++) {
+			auto i = hashes[id] & (slots - 1);
+			while (index[i].klass) i = (i + 1) & (slots - 1);
+			index[i] = { hashes[id], id + 1 };
+		}
 
-					fputs("\tAssemblyFile: ", fp);
-					if (!pAssembly->file.empty())
-					{
-						fputs(pAssembly->file.c_str(), fp);
-					}
-					fputs("\n", fp);
+		Header header{};
+		memcpy(header.magic, kMagic, sizeof(kMagic));
+		header.version     = kVersion;
+		header.pointerSize = sizeof(void*);
+		header.indexSlots  = slots;
+
+		const std::pair<const void*, size_t> blobs[] = {
+			{ strings.data(), strings.size() },
+			{ types.data(), types.size() * sizeof(TypeRecord) },
+			{ assemblies.data(), assemblies.size() * sizeof(AssemblyRecord) },
+			{ classes.data(), classes.size() * sizeof(ClassRecord) },
+			{ fields.data(), fields.size() * sizeof(FieldRecord) },
+			{ methods.data(), methods.size() * sizeof(MethodRecord) },
+			{ args.data(), args.size() * sizeof(ArgRecord) },
+			{ index.data(), index.size() * sizeof(IndexSlot) },
+		};
+		std::uint64_t offset = sizeof(Header);
+		for (size_t i = 0; i < std::size(blobs); i++) {
+			header.sections[i] = { offset, blobs[i].second };
+			offset             = (offset + blobs[i].second + 7) & ~std::uint64_t{ 7 };
+		}
 
-					fputs("\tClass: ", fp);
-					fputs(pClass->name.c_str(), fp);
-					if (!pClass->parent.empty())
-					{
-						fprintf(fp, " : %s", pClass->parent.c_str());
-					}
-					fprintf(fp, " {\n\n");
+		BufferedWriter out(path, 1 << 20);
+		out.Write(&header, sizeof(header));
+		for (size_t i = 0; i < std::size(blobs); i++) {
+			static const char zeros[8] = {};
+			out.Write(blobs[i].first, blobs[i].second);
+			out.Write(zeros, (8 - blobs[i].second % 8) % 8);
+		}
+		return out.Flush();
+	}
 
-					for (const auto &pField : pClass->fields)
-					{
-						fprintf(fp, "\t\t");
-						fprintf(fp, "%#08x | ", pField->offset);
+	/**
+	 * \brief DumpToFile writes printf-formatted output, DumpToCFile the iostream-formatted variant
+	 */
+	enum class DumpFormat { Printf, Stream };
 
-						if (pField->static_field)
-						{
-							fprintf(fp, "static ");
-						}
+	struct DumpOptions final {
+		bool     compress{ false };         // write <name>.gz instead, fails without UNITY_RESOLVE_USE_MINIZ
+		unsigned threads{ 0 };              // formatting workers, 0 = hardware_concurrency()
+		size_t   classesPerChunk{ 256 };    // unit of work handed to a worker
+		size_t   chunksInFlight{ 64 };      // bounds memory held by formatted-but-unwritten chunks
+	};
 
-						fprintf(fp, "%s %s;\n", pField->type->name.c_str(), pField->name.c_str());
-					}
-					fprintf(fp, "\n");
-
-					for (const auto &pMethod : pClass->methods)
-					{
-						fprintf(fp, "\t\t[Flags: ");
-						fprintf(fp, "%s] ", std::bitset<32>(pMethod->flags).to_string().c_str());
-						fprintf(fp, "[ParamsCount: %4d] ", pMethod->args.size());
-						fprintf(fp, "|RVA: ");
-						{
-							// io << std::showpos << std::internal << std::setfill('0');
-							std::string RVA = get_module_name_and_offset(pMethod->function);
-							fprintf(fp, "%s", RVA.c_str());
-						}
-						fprintf(fp, "|\n");
+	static auto DumpToCFile(const std::string& path) -> void { DumpToCFile(path, DumpOptions{}); }
 
-						fprintf(fp, "\t\t");
-						if (pMethod->static_function)
-						{
-							fprintf(fp, "static ");
-						}
-						fprintf(fp, "%s %s(", pMethod->return_type->name.c_str(), pMethod->name.c_str());
+	static auto DumpToCFile(const std::string& path, const DumpOptions& options) -> void {
+		if (!WriteTextDump(path + "dump.cs", DumpFormat::Stream, false, options)) return;
+		LOG_INFOS("go here");
+		WriteTextDump(path + "struct.hpp", DumpFormat::Stream, true, options);
+		LOG_INFOS("go here");
+	}
 
-						std::string params;
-						for (const auto &pArg : pMethod->args)
-						{
-							params += pArg->pType->name + " " + pArg->name + ", ";
-						}
-						if (!params.empty())
-						{
-							params.pop_back();
-							params.pop_back();
-						}
-						fprintf(fp, "%s", params.c_str());
+	static auto DumpToFile(const std::string& path) -> void { DumpToFile(path, DumpOptions{}); }
 
-						fprintf(fp, ");\n\n");
-					}
+	static auto DumpToFile(const std::string& path, const DumpOptions& options) -> void {
+		if (!WriteTextDump(path + "dump.cs", DumpFormat::Printf, false, options)) return;
+		LOG_INFOS("go here");
+		WriteTextDump(path + "struct.hpp", DumpFormat::Printf, true, options);
+		LOG_INFOS("go here");
+	}
 
-					fprintf(fp, "\t}\n\n");
-				}
-			}
+	/**
+	 * \brief formatting state for one run of classes
+	 *
+	 * The Stream format reproduces what the original std::ofstream code printed, including the
+	 * sticky setfill('0')/uppercase it picked up from earlier output. That state is carried in
+	 * zeroFill so chunks can be formatted independently and still concatenate to the same bytes.
+	 */
+	struct DumpChunk final {
+		DumpFormat  format;
+		bool        zeroFill;
+		bool        dry;       // only track zeroFill, produce no text
+		std::string text;
+
+		auto Append(const std::string& str) -> void { text += str; }
+
+		auto Append(const char* str) -> void { text += str; }
+
+		__attribute__((format(printf, 2, 3))) auto Appendf(const char* fmt, ...) -> void {
+			va_list args, measure;
+			va_start(args, fmt);
+			va_copy(measure, args);
+			const auto len = vsnprintf(nullptr, 0, fmt, measure);
+			va_end(measure);
+			if (len > 0) {
+				const auto size = text.size();
+				text.resize(size + len + 1);
+				vsnprintf(&text[size], len + 1, fmt, args);
+				text.resize(size + len);
+			}
+			va_end(args);
+		}
+	};
 
-			fputc('\n', fp);
-			fclose(fp);
+	static auto FormatClassDump(DumpChunk& chunk, const Assembly* pAssembly, const Class* pClass) -> void {
+		const auto stream = chunk.format == DumpFormat::Stream;
+		if (chunk.dry) {
+			if (!pClass->fields.empty()) chunk.zeroFill = true;
+			return;
 		}
 
-		LOG_INFOS("go here");
-    
-		{
+		chunk.Append("\tnamespace: ");
+		chunk.Append(pClass->namespaze);
+		chunk.Append("\n\tAssembly: ");
+		chunk.Append(pAssembly->name);
+		chunk.Append("\n\tAssemblyFile: ");
+		chunk.Append(pAssembly->file);
+		chunk.Append(stream ? "\n\tclass " : "\n\tClass: ");
+		chunk.Append(pClass->name);
+		if (!pClass->parent.empty()) {
+			chunk.Append(" : ");
+			chunk.Append(pClass->parent);
+		}
+		chunk.Append(" {\n\n");
+
+		for (const auto& pField : pClass->fields) {
+			chunk.Appendf(stream ? "\t\t%08x | " : "\t\t%#08x | ", static_cast<unsigned>(pField->offset));
+			if (pField->static_field) chunk.Append("static ");
+			chunk.Append(pField->type->name);
+			chunk.Append(" ");
+			chunk.Append(pField->name);
+			chunk.Append(";\n");
+			chunk.zeroFill = true;
+		}
+		chunk.Append("\n");
+
+		for (const auto& pMethod : pClass->methods) {
+			chunk.Append("\t\t[Flags: ");
+			chunk.Append(std::bitset<32>(pMethod->flags).to_string());
+			if (stream) chunk.Appendf(chunk.zeroFill ? "] [ParamsCount: %04zu] |RVA: " : "] [ParamsCount: %4zu] |RVA: ", pMethod->args.size());
+			else chunk.Appendf("] [ParamsCount: %4d] |RVA: ", static_cast<int>(pMethod->args.size()));
+			chunk.Append(get_module_name_and_offset(pMethod->function));
+			chunk.Append("|\n\t\t");
+			if (pMethod->static_function) chunk.Append("static ");
+			chunk.Append(pMethod->return_type->name);
+			chunk.Append(" ");
+			chunk.Append(pMethod->name);
+			chunk.Append("(");
+			for (size_t i = 0; i < pMethod->args.size(); i++) {
+				if (i) chunk.Append(", ");
+				chunk.Append(pMethod->args[i]->pType->name);
+				chunk.Append(" ");
+				chunk.Append(pMethod->args[i]->name);
+			}
+			chunk.Append(");\n\n");
+		}
 
-			std::string csStructPath = path + "struct.hpp";
-			FILE* fp = fopen(csStructPath.c_str(), "w");
-			if(!fp) return;
+		chunk.Append("\t}\n\n");
+	}
 
-        for (const auto& pAssembly : assembly_) {
-            for (const auto& pClass : pAssembly->classes) {
-                fprintf(fp, "namespace: ");
-                if (!pClass->namespaze.empty()) {
-                    fprintf(fp, "%s", pClass->namespaze.c_str());
-                }
-                fprintf(fp, "\n");
-    
-                fprintf(fp, "Assembly: ");
-                if (!pAssembly->name.empty()) {
-                    fprintf(fp, "%s", pAssembly->name.c_str());
-                }
-                fprintf(fp, "\n");
-    
-                fprintf(fp, "AssemblyFile: ");
-                if (!pAssembly->file.empty()) {
-                    fprintf(fp, "%s", pAssembly->file.c_str());
-                }
-                fprintf(fp, "\n");
-    
-                fprintf(fp, "struct %s", pClass->name.c_str());
-                if (!pClass->parent.empty()) {
-                    fprintf(fp, " : %s", pClass->parent.c_str());
-                }
-                fprintf(fp, " {\n\n");
-    
-                for (size_t i = 0; i < pClass->fields.size(); i++) {
-                    if (pClass->fields[i]->static_field) {
-                        continue;
-                    }
-    
-                    auto field = pClass->fields[i];
-    
-                next:
-                    if ((i + 1) >= pClass->fields.size()) {
-                        fprintf(fp, "\t\tchar %s[0x%x];\n", field->name.c_str(), 4);
-                        continue;
-                    }
-    
-                    if (pClass->fields[i + 1]->static_field) {
-                        i++;
-                        goto next;
-                    }
-    
-                    std::string name = field->name;
-                    std::replace(name.begin(), name.end(), '<', '_');
-                    std::replace(name.begin(), name.end(), '>', '_');
-    
-                    if (field->type->name == "System.Int64") {
-                        fprintf(fp, "\t\tstd::int64_t %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 8) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - 8);
-                        }
-                        continue;
-                    }
-    
-                    if (field->type->name == "System.UInt64") {
-                        fprintf(fp, "\t\tstd::uint64_t %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 8) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - 8);
-                        }
-                        continue;
-                    }
-    
-                    if (field->type->name == "System.Int32") {
-                        fprintf(fp, "\t\tint %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 4) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - 4);
-                        }
-                        continue;
-                    }
-    
-                    if (field->type->name == "System.UInt32") {
-                        fprintf(fp, "\t\tstd::uint32_t %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 4) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - 4);
-                        }
-                        continue;
-                    }
+	static auto FormatStructDump(DumpChunk& chunk, const Assembly* pAssembly, const Class* pClass) -> void {
+		// how the padding after a field of a known type was printed
+		enum class Pad {
+			Int,        // "%x" of an int gap; Stream: width 6 with whatever fill is current
+			IntSticky,  // "%x" of an int gap; Stream: switches to uppercase/zero fill first
+			Boolean,    // "%06X" of an int gap through a scratch stringstream
+			Vector,     // "%06zX" of a size_t gap through a scratch stringstream
+			SizeSticky, // "%x" of a size_t gap; Stream: switches to uppercase/zero fill first
+		};
+		struct Known {
+			const char* typeName;
+			const char* cppType;
+			size_t      size;
+			Pad         pad;
+		};
+		static const Known known[] = {
+			{ "System.Int64", "std::int64_t", 8, Pad::Int },
+			{ "System.UInt64", "std::uint64_t", 8, Pad::Int },
+			{ "System.Int32", "int", 4, Pad::Int },
+			{ "System.UInt32", "std::uint32_t", 4, Pad::Int },
+			{ "System.Boolean", "bool", 1, Pad::Boolean },
+			{ "System.String", "UnityResolve::UnityType::String*", sizeof(void*), Pad::SizeSticky },
+			{ "System.Single", "float", 4, Pad::IntSticky },
+			{ "System.Double", "double", 8, Pad::IntSticky },
+			{ "UnityEngine.Vector3", "UnityResolve::UnityType::Vector3", sizeof(UnityType::Vector3), Pad::Vector },
+			{ "UnityEngine.Vector2", "UnityResolve::UnityType::Vector2", sizeof(UnityType::Vector2), Pad::Vector },
+			{ "UnityEngine.Vector4", "UnityResolve::UnityType::Vector4", sizeof(UnityType::Vector4), Pad::Vector },
+			{ "UnityEngine.GameObject", "UnityResolve::UnityType::GameObject*", sizeof(void*), Pad::SizeSticky },
+			{ "UnityEngine.Transform", "UnityResolve::UnityType::Transform*", sizeof(void*), Pad::SizeSticky },
+			{ "UnityEngine.Animator", "UnityResolve::UnityType::Animator*", sizeof(void*), Pad::SizeSticky },
+			{ "UnityEngine.Physics", "UnityResolve::UnityType::Physics*", sizeof(void*), Pad::SizeSticky },
+			{ "UnityEngine.Component", "UnityResolve::UnityType::Component*", sizeof(void*), Pad::SizeSticky },
+			{ "UnityEngine.Rect", "UnityResolve::UnityType::Rect", sizeof(UnityType::Rect), Pad::SizeSticky },
+			{ "UnityEngine.Quaternion", "UnityResolve::UnityType::Quaternion", sizeof(UnityType::Quaternion), Pad::SizeSticky },
+			{ "UnityEngine.Color", "UnityResolve::UnityType::Color", sizeof(UnityType::Color), Pad::SizeSticky },
+			{ "UnityEngine.Matrix4x4", "UnityResolve::UnityType::Matrix4x4", sizeof(UnityType::Matrix4x4), Pad::SizeSticky },
+			{ "UnityEngine.Rigidbody", "UnityResolve::UnityType::Rigidbody*", sizeof(void*), Pad::SizeSticky },
+		};
 
-                    if (field->type->name == "System.Boolean") {
-                        fprintf(fp, "\t\tbool %s;\n", name.c_str());
+		const auto stream = chunk.format == DumpFormat::Stream;
+		const auto& fields = pClass->fields;
+		const auto  emit   = !chunk.dry;
+
+		if (emit) {
+			chunk.Append(stream ? "\tnamespace: " : "namespace: ");
+			chunk.Append(pClass->namespaze);
+			chunk.Append(stream ? "\n\tAssembly: " : "\nAssembly: ");
+			chunk.Append(pAssembly->name);
+			chunk.Append(stream ? "\n\tAssemblyFile: " : "\nAssemblyFile: ");
+			chunk.Append(pAssembly->file);
+			chunk.Append(stream ? "\n\tstruct " : "\nstruct ");
+			chunk.Append(pClass->name);
+			if (!pClass->parent.empty()) {
+				chunk.Append(" : ");
+				chunk.Append(pClass->parent);
+			}
+			chunk.Append(" {\n\n");
+		}
 
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 1) {
-                            std::stringstream hexPadding;
-                            hexPadding << std::hex << std::uppercase << std::setfill('0') << std::setw(6) << (pClass->fields[i + 1]->offset - field->offset - 1);
-                            fprintf(fp, "\t\tchar %s_[0x%s];\n", name.c_str(), hexPadding.str().c_str());
-                        }
+		for (size_t i = 0; i < fields.size(); i++) {
+			if (fields[i]->static_field) continue;
 
-                        continue;
-                    }
+			const auto field = fields[i];
+			while (i + 1 < fields.size() && fields[i + 1]->static_field) i++;
 
-                    if (field->type->name == "System.String") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::String* %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - sizeof(void*));
-                        }
-                        continue;
-                    }
+			if (i + 1 >= fields.size()) {
+				if (!emit) continue;
+				chunk.Append("\t\tchar ");
+				chunk.Append(field->name);
+				if (stream) chunk.Appendf(chunk.zeroFill ? "[0x%06X];\n" : "[0x%6x];\n", 4);
+				else chunk.Append("[0x4];\n");
+				continue;
+			}
 
-                    if (field->type->name == "System.Single") {
-                        fprintf(fp, "\t\tfloat %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 4) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - 4);
-                        }
-                        continue;
-                    }
+			const int gap = fields[i + 1]->offset - field->offset;
 
-                    if (field->type->name == "System.Double") {
-                        fprintf(fp, "\t\tdouble %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > 8) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - 8);
-                        }
-                        continue;
-                    }
+			std::string name = field->name;
+			std::replace(name.begin(), name.end(), '<', '_');
+			std::replace(name.begin(), name.end(), '>', '_');
 
-                    if (field->type->name == "UnityEngine.Vector3") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::Vector3 %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Vector3)) {
-                            std::stringstream buffer;
-                            buffer << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Vector3));
-                            fprintf(fp, "\t\tchar %s_[0x%s];\n", name.c_str(), buffer.str().c_str());
-                        }
-                        continue;
-                    }
+			const Known* kind = nullptr;
+			for (const auto& k : known) {
+				if (field->type->name == k.typeName) {
+					kind = &k;
+					break;
+				}
+			}
 
-                    if (field->type->name == "UnityEngine.Vector2") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::Vector2 %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Vector2)) {
-                            std::stringstream buffer;
-                            buffer << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Vector2));
-                            fprintf(fp, "\t\tchar %s_[0x%s];\n", name.c_str(), buffer.str().c_str());
-                        }
-                        continue;
-                    }
+			if (!kind) {
+				if (stream) chunk.zeroFill = true;
+				if (!emit) continue;
+				chunk.Append("\t\tchar ");
+				chunk.Append(name);
+				chunk.Appendf(stream ? "[0x%06X];\n" : "[0x%x];\n", static_cast<unsigned>(gap));
+				continue;
+			}
+
+			if (emit) {
+				chunk.Append("\t\t");
+				chunk.Append(kind->cppType);
+				chunk.Append(" ");
+				chunk.Append(name);
+				chunk.Append(";\n");
+			}
+
+			const auto sizeGap = static_cast<size_t>(gap) - kind->size;
+			const auto intGap  = gap - static_cast<int>(kind->size);
+			switch (kind->pad) {
+				case Pad::Int:
+					if (!emit || intGap <= 0) break;
+					if (stream) chunk.Appendf(chunk.zeroFill ? "\t\tchar %s_[0x%06X];\n" : "\t\tchar %s_[0x%6x];\n", name.c_str(), static_cast<unsigned>(intGap));
+					else chunk.Appendf("\t\tchar %s_[0x%x];\n", name.c_str(), static_cast<unsigned>(intGap));
+					break;
+				case Pad::IntSticky:
+					if (intGap <= 0) break;
+					if (stream) chunk.zeroFill = true;
+					if (emit) chunk.Appendf(stream ? "\t\tchar %s_[0x%06X];\n" : "\t\tchar %s_[0x%x];\n", name.c_str(), static_cast<unsigned>(intGap));
+					break;
+				case Pad::Boolean:
+					if (!emit || intGap <= 0) break;
+					chunk.Appendf("\t\tchar %s_[0x%06X];\n", name.c_str(), static_cast<unsigned>(intGap));
+					break;
+				case Pad::Vector:
+					if (!emit || static_cast<size_t>(gap) <= kind->size) break;
+					chunk.Appendf("\t\tchar %s_[0x%06zX];\n", name.c_str(), sizeGap);
+					break;
+				case Pad::SizeSticky:
+					if (static_cast<size_t>(gap) <= kind->size) break;
+					if (stream) chunk.zeroFill = true;
+					if (!emit) break;
+					if (stream) chunk.Appendf("\t\tchar %s_[0x%06zX];\n", name.c_str(), sizeGap);
+					else chunk.Appendf("\t\tchar %s_[0x%x];\n", name.c_str(), static_cast<unsigned>(sizeGap));
+					break;
+			}
+		}
 
-                    if (field->type->name == "UnityEngine.Vector4") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::Vector4 %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Vector4)) {
-                            std::stringstream buffer;
-                            buffer << std::hex << std::uppercase << std::setfill('0') << std::setw(6)
-                                << (pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Vector4));
-                            fprintf(fp, "\t\tchar %s_[0x%s];\n", name.c_str(), buffer.str().c_str());
-                        }
-                        continue;
-                    }
+		if (emit) chunk.Append("\t}\n\n");
+	}
 
-                    if (field->type->name == "UnityEngine.GameObject") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::GameObject* %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - sizeof(void*));
-                        }
-                        continue;
-                    }
+	/**
+	 * \brief format the model on worker threads in class-range chunks and write them in order
+	 *
+	 * The caller's thread only waits for chunk k and hands it to the output, so the file is
+	 * produced with a few large writes while at most chunksInFlight chunks are held in memory.
+	 */
+	static auto WriteTextDump(const std::string& path, const DumpFormat format, const bool structs, const DumpOptions& options) -> bool {
+		struct Range {
+			const Assembly* assembly;
+			size_t          begin;
+			size_t          end;
+			bool            zeroFill;
+		};
 
-                    if (field->type->name == "UnityEngine.Transform") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::Transform* %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - sizeof(void*));
-                        }
-                        continue;
-                    }
+		const auto per = std::max<size_t>(options.classesPerChunk, 1);
+		std::vector<Range> ranges;
+		for (const auto pAssembly : assembly_)
+			for (size_t i = 0; i < pAssembly->classes.size(); i += per)
+				ranges.push_back({ pAssembly, i, std::min(i + per, pAssembly->classes.size()), false });
 
-                    if (field->type->name == "UnityEngine.Animator") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::Animator* %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - sizeof(void*));
-                        }
-                        continue;
-                    }
+		const auto formatRange = [&](DumpChunk& chunk, const Range& range) {
+			for (auto i = range.begin; i < range.end; i++) {
+				if (chunk.dry && chunk.zeroFill) return;
+				if (structs) FormatStructDump(chunk, range.assembly, range.assembly->classes[i]);
+				else FormatClassDump(chunk, range.assembly, range.assembly->classes[i]);
+			}
+		};
 
-                    if (field->type->name == "UnityEngine.Physics") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::Physics* %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - sizeof(void*));
-                        }
-                        continue;
-                    }
+		// the sticky stream state only ever turns on, so a dry pass stops at the first chunk that sets it
+		if (format == DumpFormat::Stream) {
+			auto state = false;
+			for (auto& range : ranges) {
+				range.zeroFill = state;
+				if (state) continue;
+				DumpChunk dry{ format, false, true, {} };
+				formatRange(dry, range);
+				state = dry.zeroFill;
+			}
+		}
 
-                    if (field->type->name == "UnityEngine.Component") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::Component* %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - sizeof(void*));
-                        }
-                        continue;
-                    }
+		const char* trailer = structs && format == DumpFormat::Printf ? "\n\n" : "\n";
 
-                    if (field->type->name == "UnityEngine.Rect") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::Rect %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Rect)) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Rect));
-                        }
-                        continue;
-                    }
+#ifndef UNITY_RESOLVE_USE_MINIZ
+		if (options.compress) {
+			LOG_INFOS("built without UNITY_RESOLVE_USE_MINIZ, cannot write %s.gz", path.c_str());
+			return false;
+		}
+#endif
 
-                    if (field->type->name == "UnityEngine.Quaternion") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::Quaternion %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Quaternion)) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Quaternion));
-                        }
-                        continue;
-                    }
+		BufferedWriter file(options.compress ? path + ".gz" : path, 1 << 20);
+		if (!file.Ok()) return false;
 
-                    if (field->type->name == "UnityEngine.Color") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::Color %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Color)) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Color));
-                        }
-                        continue;
-                    }
+		std::function<bool(const std::string&)> sink = [&](const std::string& text) { return file.Write(text); };
+#ifdef UNITY_RESOLVE_USE_MINIZ
+		std::unique_ptr<GzipWriter> gzip;
+		if (options.compress) {
+			gzip.reset(new GzipWriter(file));
+			sink = [&](const std::string& text) { return gzip->Write(text); };
+		}
+#endif
+
+		std::mutex               mutex;
+		std::condition_variable  cv;
+		std::vector<std::string> texts(ranges.size());
+		std::vector<char>        done(ranges.size(), 0);
+		size_t                   next    = 0;
+		size_t                   written = 0;
+		const auto               window  = std::max<size_t>(options.chunksInFlight, 1);
+
+		const auto worker = [&]() {
+			for (;;) {
+				size_t k;
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					cv.wait(lock, [&] { return next >= ranges.size() || next < written + window; });
+					if (next >= ranges.size()) return;
+					k = next++;
+				}
 
-                    if (field->type->name == "UnityEngine.Matrix4x4") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::Matrix4x4 %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(UnityType::Matrix4x4)) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - sizeof(UnityType::Matrix4x4));
-                        }
-                        continue;
-                    }
+				DumpChunk chunk{ format, ranges[k].zeroFill, false, {} };
+				formatRange(chunk, ranges[k]);
 
-                    if (field->type->name == "UnityEngine.Rigidbody") {
-                        fprintf(fp, "\t\tUnityResolve::UnityType::Rigidbody* %s;\n", name.c_str());
-                        if (!pClass->fields[i + 1]->static_field && (pClass->fields[i + 1]->offset - field->offset) > sizeof(void*)) {
-                            fprintf(fp, "\t\tchar %s_[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset - sizeof(void*));
-                        }
-                        continue;
-                    }
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					texts[k] = std::move(chunk.text);
+					done[k]  = 1;
+				}
+				cv.notify_all();
+			}
+		};
 
-                    fprintf(fp, "\t\tchar %s[0x%x];\n", name.c_str(), pClass->fields[i + 1]->offset - field->offset);
+		auto count = options.threads ? options.threads : std::thread::hardware_concurrency();
+		count      = std::max(1u, std::min<unsigned>(count, static_cast<unsigned>(ranges.size())));
+		std::vector<std::thread> workers;
+		for (unsigned i = 0; i < count; i++) workers.emplace_back(worker);
 
-                }
-    
-                fprintf(fp, "\t}\n\n");
-            }
-        }
-    
-		fprintf(fp, "\n\n");
-		fclose(fp);
-		LOG_INFOS("go here");
+		auto ok = true;
+		for (size_t k = 0; k < ranges.size(); k++) {
+			std::string text;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				cv.wait(lock, [&] { return done[k] != 0; });
+				text    = std::move(texts[k]);
+				written = k + 1;
+			}
+			cv.notify_all();
+			ok = sink(text) && ok;
 		}
-    }
+
+		for (auto& t : workers) t.join();
+
+		ok = sink(trailer) && ok;
+#ifdef UNITY_RESOLVE_USE_MINIZ
+		if (gzip) ok = gzip->Finish() && ok;
+#endif
+		return file.Flush() && ok;
+	}
 
 
 	static auto Get(const std::string& strAssembly) -> Assembly* {
@@ -1133,10 +1251,12 @@ struct UnityResolve final {
 	static auto ForeachAssembly() -> void {
         // 遍历程序集
         size_t     nrofassemblies = 0;
+        StartupProfiler::Scope profile("UnityResolve::ForeachAssembly");
         const auto** assemblies = il2cpp_domain_get_assemblies( pDomain_, &nrofassemblies);
         for (auto i = 0; i < nrofassemblies; i++) {
             const auto* ptr = assemblies[i];
             if (ptr == nullptr) continue;
+            const auto start = StartupProfiler::Clock::now();
             auto       assembly = new Assembly{ 
                                 .address = ptr 
                             };
@@ -1145,6 +1265,7 @@ struct UnityResolve final {
             assembly->name = il2cpp_image_get_name( image);
             UnityResolve::assembly_.push_back(assembly);
             ForeachClass(assembly, image);
+            StartupProfiler::Instance().Record("UnityResolve::ForeachAssembly", assembly->name, start, StartupProfiler::Clock::now());
         }
     }
 
@@ -1941,6 +2062,76 @@ struct UnityResolve final {
 			}
 		};
 
+		/**
+		 * \brief .NET GetHashCode of a dictionary key
+		 *
+		 * hashed is false when no hash is known and lookups scan the entries; exact is false when
+		 * the dictionary may use another comparer, so a miss on the bucket chain falls back to a scan.
+		 */
+		template <typename T, typename = void>
+		struct KeyHasher {
+			static constexpr bool hashed = false;
+			static constexpr bool exact  = false;
+
+			static auto Get(const T&) -> int { return 0; }
+			static auto Equals(const T& l, const T& r) -> bool { return l == r; }
+		};
+
+		template <typename T>
+		struct KeyHasher<T, std::enable_if_t<std::is_integral_v<T>>> {
+			static constexpr bool hashed = true;
+			static constexpr bool exact  = true;
+
+			// Boolean/SByte/Int16/Char/Int32/Int64 (and unsigned) GetHashCode; UInt16 is its value
+			static auto Get(const T& key) -> int {
+				if constexpr (std::is_same_v<T, bool>) return key ? 1 : 0;
+				else if constexpr (sizeof(T) == 1 && std::is_signed_v<T>) return static_cast<int>(key) ^ (static_cast<int>(key) << 8);
+				else if constexpr (sizeof(T) == 2 && (std::is_signed_v<T> || std::is_same_v<T, char16_t>)) return static_cast<int>(static_cast<std::uint16_t>(key) | (static_cast<std::uint32_t>(static_cast<int>(key)) << 16));
+				else if constexpr (sizeof(T) == 8) return static_cast<int>(static_cast<std::uint64_t>(key)) ^ static_cast<int>(static_cast<std::uint64_t>(key) >> 32);
+				else return static_cast<int>(key);
+			}
+
+			static auto Equals(const T& l, const T& r) -> bool { return l == r; }
+		};
+
+		template <typename T>
+		struct KeyHasher<T, std::enable_if_t<std::is_enum_v<T>>> {
+			using Underlying = std::underlying_type_t<T>;
+
+			static constexpr bool hashed = true;
+			static constexpr bool exact  = true;
+
+			static auto Get(const T& key) -> int { return KeyHasher<Underlying>::Get(static_cast<Underlying>(key)); }
+			static auto Equals(const T& l, const T& r) -> bool { return l == r; }
+		};
+
+		// String.GetHashCode of the non-randomized BCL
+		template <typename T>
+		struct KeyHasher<T, std::enable_if_t<std::is_same_v<T, String*>>> {
+			static constexpr bool hashed = true;
+			static constexpr bool exact  = false;
+
+			static auto Chars(const String* str) -> const char16_t* { return reinterpret_cast<const char16_t*>(str->m_firstChar); }
+
+			static auto Get(String* const& key) -> int {
+				if (!key) return 0;
+				std::uint32_t hash1 = 5381, hash2 = 5381;
+				const auto* chars = Chars(key);
+				for (int i = 0; i < key->m_stringLength; i += 2) {
+					hash1 = ((hash1 << 5) + hash1) ^ chars[i];
+					if (i + 1 >= key->m_stringLength) break;
+					hash2 = ((hash2 << 5) + hash2) ^ chars[i + 1];
+				}
+				return static_cast<int>(hash1 + hash2 * 1566083941u);
+			}
+
+			static auto Equals(String* const& l, String* const& r) -> bool {
+				if (l == r) return true;
+				if (!l || !r || l->m_stringLength != r->m_stringLength) return false;
+				return memcmp(Chars(l), Chars(r), static_cast<size_t>(l->m_stringLength) * sizeof(char16_t)) == 0;
+			}
+		};
+
 		template <typename TKey, typename TValue>
 		struct Dictionary : Object {
 			struct Entry {
@@ -1960,13 +2151,13 @@ struct UnityResolve final {
 			void* pKeys;
 			void* pValues;
 
-			auto GetEntry() -> Entry* { return static_cast<Entry*>(pEntries->GetData()); }
+			auto GetEntry() -> Entry* { return reinterpret_cast<Entry*>(pEntries->GetData()); }
 
 			auto GetKeyByIndex(const int iIndex) -> TKey {
 				TKey tKey = { 0 };
 
 				Entry* pEntry = GetEntry();
-				if (pEntry) tKey = pEntry[iIndex].m_tKey;
+				if (pEntry) tKey = pEntry[iIndex].tKey;
 
 				return tKey;
 			}
@@ -1975,18 +2166,102 @@ struct UnityResolve final {
 				TValue tValue = { 0 };
 
 				Entry* pEntry = GetEntry();
-				if (pEntry) tValue = pEntry[iIndex].m_tValue;
+				if (pEntry) tValue = pEntry[iIndex].tValue;
 
 				return tValue;
 			}
 
+			// free-list slots: the old BCL marks them with hashCode -1, corefx with next below -1
+			static auto IsFree(const Entry& entry) -> bool { return entry.iNext < -1 || entry.iHashCode == -1; }
+
+			/**
+			 * \brief index into the entries, -1 if the key is absent
+			 *
+			 * Follows the buckets/next chains like .NET does. Both the 0-based (BCL) and 1-based
+			 * (corefx) bucket encodings are tried; matches are verified on hash and key, so a wrong
+			 * guess can only miss.
+			 */
+			template <typename Hasher = KeyHasher<TKey>>
+			auto FindIndex(const TKey& tKey) -> int {
+				if (!pEntries) return -1;
+
+				Entry*    entries  = GetEntry();
+				const int capacity = static_cast<int>(pEntries->max_length);
+				if constexpr (Hasher::hashed) {
+					if (pBuckets && pBuckets->max_length) {
+						const int  raw     = Hasher::Get(tKey);
+						const int  masked  = raw & 0x7FFFFFFF;
+						const auto buckets = static_cast<std::uint32_t>(pBuckets->max_length);
+						const std::uint32_t indices[2]{ static_cast<std::uint32_t>(masked) % buckets, static_cast<std::uint32_t>(raw) % buckets };
+
+						for (int b = 0; b < (indices[0] == indices[1] ? 1 : 2); b++) {
+							const int bucket = pBuckets->At(indices[b]);
+							for (const int start : { bucket - 1, bucket }) {
+								int steps = 0;
+								for (int i = start; i >= 0 && i < capacity && steps <= iCount; i = entries[i].iNext, steps++)
+									if ((entries[i].iHashCode == masked || entries[i].iHashCode == raw) && Hasher::Equals(entries[i].tKey, tKey)) return i;
+							}
+						}
+
+						if (Hasher::exact) return -1;
+					}
+				}
+
+				for (int i = 0; i < iCount && i < capacity; i++)
+					if (!IsFree(entries[i]) && Hasher::Equals(entries[i].tKey, tKey)) return i;
+				return -1;
+			}
+
+			template <typename Hasher = KeyHasher<TKey>>
+			auto TryGetValue(const TKey& tKey, TValue* value) -> bool {
+				const auto index = FindIndex<Hasher>(tKey);
+				if (index < 0) return false;
+				*value = GetEntry()[index].tValue;
+				return true;
+			}
+
+			auto ContainsKey(const TKey& tKey) -> bool { return FindIndex(tKey) >= 0; }
+
 			auto GetValueByKey(const TKey tKey) -> TValue {
 				TValue tValue = { 0 };
-				for (auto i = 0; i < iCount; i++) if (GetEntry()[i].m_tKey == tKey) tValue = GetEntry()[i].m_tValue;
+				TryGetValue(tKey, &tValue);
 				return tValue;
 			}
 
-			auto operator[](const TKey tKey) const -> TValue { return GetValueByKey(tKey); }
+			auto operator[](const TKey tKey) -> TValue { return GetValueByKey(tKey); }
+
+			/**
+			 * \brief forward iterator over the used entries, skipping free-list slots
+			 */
+			struct Iterator {
+				Entry* entries;
+				int    index;
+				int    last;
+
+				auto Skip() -> void {
+					while (index < last && IsFree(entries[index])) index++;
+				}
+
+				auto operator*() const -> Entry& { return entries[index]; }
+				auto operator->() const -> Entry* { return &entries[index]; }
+				auto operator++() -> Iterator& {
+					index++;
+					Skip();
+					return *this;
+				}
+				auto operator==(const Iterator& other) const -> bool { return index == other.index; }
+				auto operator!=(const Iterator& other) const -> bool { return index != other.index; }
+			};
+
+			auto begin() -> Iterator {
+				Iterator it{ pEntries ? GetEntry() : nullptr, 0, Used() };
+				it.Skip();
+				return it;
+			}
+
+			auto end() -> Iterator { return { nullptr, Used(), Used() }; }
+
+			auto Used() const -> int { return pEntries ? std::min(iCount, static_cast<int>(pEntries->max_length)) : 0; }
 		};
 
 		struct UnityObject : Object {
@@ -2755,6 +3030,9 @@ public:
 	static std::unordered_map<std::string, void*> address_;
 	static Il2CppDomain* pDomain_;
 	static Il2CppThread* pThread_;
+	static ThreadAttachStats attachStats_;
+	static MethodIndex methodIndex_;
+	static NameSearch nameSearch_;
 
 };
 
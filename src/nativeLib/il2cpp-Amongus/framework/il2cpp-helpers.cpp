@@ -4,6 +4,8 @@
 #include <optional>
 #include <thread>
 #include <chrono>
+#include <mutex>
+#include <unordered_map>
 #include "logger.h"
 
 static std::vector<std::string> Tokenize(std::string_view str, std::string_view delimiters) {
@@ -127,66 +129,121 @@ std::string get_method_params(const MethodInfo* methodInfo) {
 	return params;
 }
 
-bool method_compare(const MethodInfo* methodInfo, std::string_view returnType, std::string_view methodName, std::string_view paramTypes) {
-	if (methodName.compare(methodInfo->name) != 0) return false;
-	if (returnType.compare(get_type_name(methodInfo->return_type)) != 0) return false;
-	if (paramTypes.compare(get_method_params(methodInfo)) != 0) return false;
+// FNV-1a over the parts of a signature, ignoring spaces so "A,B" and "A, B" hash the same.
+static uint64_t signature_hash(uint64_t hash, std::string_view part) {
+	for (char c : part) {
+		if (c == ' ') continue;
+		hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+	}
+	return hash;
+}
 
-	return true;
+static uint64_t signature_hash(std::string_view returnType, std::string_view paramTypes) {
+	uint64_t hash = 14695981039346656037ull;
+	hash = signature_hash(hash, returnType);
+	hash = signature_hash(hash, "(");
+	hash = signature_hash(hash, paramTypes);
+	return signature_hash(hash, ")");
 }
 
+// Method name -> overloads, built the first time a class is searched from the method names
+// alone. Type names are formatted, and hashed, only for the overloads of a name that is looked
+// up, once per method.
+struct method_overload {
+	const MethodInfo* method;
+	uint64_t hash;
+	bool hashed;
+};
+
+using method_index = std::unordered_map<std::string_view, std::vector<method_overload>>;
+
 Il2CppMethodPointer find_method(Il2CppClass* klass, std::string_view returnType, std::string_view methodName, std::string_view paramTypes) {
+	static std::mutex mutex;
+	static std::unordered_map<Il2CppClass*, method_index> indices;
+
 	methodName = translate_method_name(methodName);
+	const uint64_t hash = signature_hash(returnType, paramTypes);
+
+	std::lock_guard lock(mutex);
+	auto [it, inserted] = indices.try_emplace(klass);
+	if (inserted) {
+		void* iterator = NULL;
+		const MethodInfo* method = NULL;
+		while ((method = il2cpp_class_get_methods(klass, &iterator)) != NULL)
+			it->second[method->name].push_back({ method, 0, false });
+	}
 
-	void* iterator = NULL;
-	const MethodInfo* method = NULL;
+	auto overloads = it->second.find(methodName);
+	if (overloads == it->second.end()) return NULL;
 
-	while ((method = il2cpp_class_get_methods(klass, &iterator)) != NULL) {
-		if (method_compare(method, returnType, methodName, paramTypes)) return method->methodPointer;
+	for (auto& overload : overloads->second) {
+		if (!overload.hashed) {
+			overload.hash = signature_hash(get_type_name(overload.method->return_type), get_method_params(overload.method));
+			overload.hashed = true;
+		}
+		if (overload.hash == hash) return overload.method->methodPointer;
 	}
 
 	return NULL;
 }
 
-Il2CppMethodPointer get_method(std::string methodSignature) {
-	std::string assemblyName = methodSignature.substr(0, methodSignature.find(", "));
-	methodSignature.erase(0, assemblyName.length() + 2);
+bool parse_method_signature(std::string_view signature, method_signature& out) {
+	auto pos = signature.find(", ");
+	if (pos == std::string_view::npos) return false;
+	out.assembly = signature.substr(0, pos);
+	signature.remove_prefix(pos + 2);
 
-	std::string returnType = methodSignature.substr(0, methodSignature.find(" "));
-	methodSignature.erase(0, returnType.length() + 1);
+	if ((pos = signature.find(' ')) == std::string_view::npos) return false;
+	out.returnType = signature.substr(0, pos);
+	signature.remove_prefix(pos + 1);
 
-	std::string methodName = methodSignature.substr(methodSignature.rfind("::") + 2);
-	methodSignature.erase(methodSignature.rfind("::"));
+	auto open = signature.find('(');
+	if (open == std::string_view::npos || signature.back() != ')') return false;
+	out.paramTypes = signature.substr(open + 1, signature.length() - open - 2);
 
-	std::string namespaze = "";
-	if (auto pos = methodSignature.rfind("."); pos != std::string::npos) {
-		namespaze = methodSignature.substr(0, pos);
-		methodSignature.erase(0, namespaze.length() + 1);
+	if ((pos = signature.rfind("::", open)) == std::string_view::npos) return false;
+	out.methodName = signature.substr(pos + 2, open - pos - 2);
+	signature = signature.substr(0, pos);
+
+	out.namespaze = {};
+	if ((pos = signature.rfind('.')) != std::string_view::npos) {
+		out.namespaze = signature.substr(0, pos);
+		signature.remove_prefix(pos + 1);
 	}
+	out.className = signature;
+	return true;
+}
 
-	std::string className = methodSignature;
+bool parse_class_signature(std::string_view signature, method_signature& out) {
+	auto pos = signature.find(", ");
+	if (pos == std::string_view::npos) return false;
+	out = {};
+	out.assembly = signature.substr(0, pos);
+	signature.remove_prefix(pos + 2);
+
+	if ((pos = signature.rfind('.')) != std::string_view::npos) {
+		out.namespaze = signature.substr(0, pos);
+		signature.remove_prefix(pos + 1);
+	}
+	out.className = signature;
+	return true;
+}
 
-	std::string paramTypes = methodName.substr(methodName.find("(") + 1);
-	methodName.erase(methodName.rfind("("));
-	paramTypes.pop_back();
+Il2CppMethodPointer get_method(std::string_view methodSignature) {
+	method_signature signature;
+	if (!parse_method_signature(methodSignature, signature)) return NULL;
 
-	Il2CppClass* klass = get_class(assemblyName, namespaze, className);
+	Il2CppClass* klass = get_class(signature.assembly, std::string(signature.namespaze), std::string(signature.className));
 	if (klass == NULL) return NULL;
 
-	return find_method(klass, returnType, methodName, paramTypes);
+	return find_method(klass, signature.returnType, signature.methodName, signature.paramTypes);
 }
 
-Il2CppClass* get_class(std::string classSignature) {
-	std::string assemblyName = classSignature.substr(0, classSignature.find(", "));
-	classSignature.erase(0, assemblyName.length() + 2);
+Il2CppClass* get_class(std::string_view classSignature) {
+	method_signature signature;
+	if (!parse_class_signature(classSignature, signature)) return NULL;
 
-	std::string namespaze = "";
-	if (classSignature.rfind(".") != std::string::npos) {
-		namespaze = classSignature.substr(0, classSignature.rfind("."));
-		classSignature.erase(0, namespaze.length() + 1);
-	}
-
-	return get_class(assemblyName, namespaze, classSignature);
+	return get_class(signature.assembly, std::string(signature.namespaze), std::string(signature.className));
 }
 
 Il2CppClass* get_class(std::string_view assemblyName, std::string namespaze, std::string className) {
@@ -194,8 +251,14 @@ Il2CppClass* get_class(std::string_view assemblyName, std::string namespaze, std
 	namespaze = klass_translation.namespaze;
 	className = klass_translation.klass_name;
 
+	// assemblyName may be a view into a longer signature
+	char assemblyBuffer[256];
+	if (assemblyName.length() >= sizeof(assemblyBuffer)) return NULL;
+	assemblyName.copy(assemblyBuffer, assemblyName.length());
+	assemblyBuffer[assemblyName.length()] = '\0';
+
 	Il2CppDomain* domain = il2cpp_domain_get();
-	const Il2CppAssembly* assembly = il2cpp_domain_assembly_open(domain, assemblyName.data());
+	const Il2CppAssembly* assembly = il2cpp_domain_assembly_open(domain, assemblyBuffer);
 	if (assembly == NULL) return NULL;
 
 	const auto& vecClassNames = Tokenize(className, "+");
@@ -1,13 +1,29 @@
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <string_view>
+#include <vector>
 
 void new_console();
 std::string convert_from_string(Il2CppString* input);
 std::string convert_from_string(app::String* input);
 app::String* convert_to_string(std::string_view input);
 std::string translate_type_name(std::string input);
+// Views into a DO_APP_FUNC / DO_APP_CLASS signature string, e.g.
+// "Assembly-CSharp, System.Void Namespace.Class+Nested::Method(System.Int32, System.Single)"
+struct method_signature {
+	std::string_view assembly;
+	std::string_view returnType;
+	std::string_view namespaze;
+	std::string_view className;
+	std::string_view methodName;
+	std::string_view paramTypes;
+};
+bool parse_method_signature(std::string_view signature, method_signature& out);
+bool parse_class_signature(std::string_view signature, method_signature& out);
 Il2CppMethodPointer find_method(Il2CppClass* klass, std::string_view returnType, std::string_view methodName, std::string_view paramTypes);
-Il2CppMethodPointer get_method(std::string methodSignature);
-Il2CppClass* get_class(std::string classSignature);
+Il2CppMethodPointer get_method(std::string_view methodSignature);
+Il2CppClass* get_class(std::string_view classSignature);
 Il2CppClass* get_class(std::string_view assemblyName, std::string namespaze, std::string className);
 std::string get_method_description(const MethodInfo* methodInfo);
 void output_class_methods(Il2CppClass* klass);
@@ -20,6 +36,40 @@ inline constexpr bool is_scoped_enum_v = std::conjunction_v<std::is_enum<_Ty>, s
 
 namespace app {
 	namespace il2cpp {
+		// System.XXX.GetHashCode of the key types the default comparers hash without boxing.
+		// Dictionary verifies the result against the stored hash codes before trusting it.
+		template<typename T, typename = void>
+		struct key_hash {
+			static constexpr bool supported = false;
+		};
+		template<typename T>
+		struct key_hash<T, std::enable_if_t<std::is_integral_v<T>>> {
+			static constexpr bool supported = true;
+			static int32_t get(T value) {
+				if constexpr (std::is_same_v<T, bool>)
+					return value ? 1 : 0;
+				else if constexpr (sizeof(T) == 8)
+					return static_cast<int32_t>(static_cast<uint32_t>(value) ^ static_cast<uint32_t>(static_cast<uint64_t>(value) >> 32));
+				else if constexpr (sizeof(T) == 4)
+					return static_cast<int32_t>(value);
+				else if constexpr (std::is_same_v<T, char16_t> || std::is_same_v<T, wchar_t>)
+					return static_cast<int32_t>(static_cast<uint32_t>(value) | (static_cast<uint32_t>(value) << 16));
+				else if constexpr (sizeof(T) == 2 && std::is_signed_v<T>)
+					return static_cast<int32_t>(static_cast<uint16_t>(value) | (static_cast<uint32_t>(value) << 16));
+				else if constexpr (sizeof(T) == 1 && std::is_signed_v<T>)
+					return static_cast<int32_t>(static_cast<uint32_t>(value) ^ (static_cast<uint32_t>(value) << 8));
+				else
+					return static_cast<int32_t>(value);
+			}
+		};
+		template<typename T>
+		struct key_hash<T, std::enable_if_t<std::is_enum_v<T>>> {
+			static constexpr bool supported = true;
+			static int32_t get(T value) {
+				return key_hash<std::underlying_type_t<T>>::get(static_cast<std::underlying_type_t<T>>(value));
+			}
+		};
+
 		template<typename E>
 		class Dictionary {
 		public:
@@ -30,8 +80,7 @@ namespace app {
 			constexpr Dictionary(E* dict) : _Ptr(dict) {}
 			constexpr size_t size() const {
 				if (!_Ptr) return 0;
-				auto pDict = (Dictionary_2_SystemTypes_ISystemType_*)_Ptr;
-				return ((size_t(*)(void*, const void*))(pDict->klass->vtable.get_Count.methodPtr))(pDict, pDict->klass->vtable.get_Count.method);
+				return static_cast<size_t>(_Ptr->fields.count - _Ptr->fields.freeCount);
 			}
 			constexpr iterator begin() const {
 				if (!_Ptr) return nullptr;
@@ -41,9 +90,7 @@ namespace app {
 			constexpr pointer operator[](const key_type& _Keyval) const {
 				static_assert(std::is_arithmetic_v<key_type> || is_scoped_enum_v<key_type>);
 				if (!_Ptr) return nullptr;
-				const auto FindEntryMethod = ((System_Collections_Generic_Dictionary_TKey__TValue__RGCTXs*)(_Ptr->klass->rgctx_data))
-					->_17_System_Collections_Generic_Dictionary_TKey__TValue__FindEntry;
-				auto num = ((int32_t(*)(void*, key_type, const void*))(FindEntryMethod->methodPointer))(_Ptr, _Keyval, FindEntryMethod);
+				auto num = find_entry(_Keyval);
 				if (num < 0)
 					return nullptr;
 				if constexpr (std::is_pointer_v<value_type>)
@@ -51,8 +98,106 @@ namespace app {
 				else
 					return &_Ptr->fields.entries->vector[num].value;
 			}
+			// Entry index of the key or -1. Reads buckets/entries directly when the dictionary
+			// uses a default comparer whose hash matches key_hash, otherwise calls FindEntry.
+			int32_t find_entry(const key_type& _Keyval) const {
+				if (!_Ptr) return -1;
+				if constexpr (key_hash<key_type>::supported) {
+					if (can_probe())
+						return probe_entry(_Keyval);
+				}
+				return managed_find_entry(_Keyval);
+			}
+			int32_t managed_find_entry(const key_type& _Keyval) const {
+				const auto FindEntryMethod = ((System_Collections_Generic_Dictionary_TKey__TValue__RGCTXs*)(_Ptr->klass->rgctx_data))
+					->_17_System_Collections_Generic_Dictionary_TKey__TValue__FindEntry;
+				return ((int32_t(*)(void*, key_type, const void*))(FindEntryMethod->methodPointer))(_Ptr, _Keyval, FindEntryMethod);
+			}
+			struct benchmark_result {
+				size_t lookups = 0;
+				size_t mismatches = 0;
+				bool probed = false;
+				double direct_ns = 0;	// per lookup
+				double managed_ns = 0;
+			};
+			// Looks up every key `rounds` times through find_entry and through FindEntry, and
+			// counts keys where the two disagree.
+			benchmark_result benchmark(size_t rounds = 100) const {
+				benchmark_result result;
+				if (!_Ptr || !_Ptr->fields.entries) return result;
+
+				std::vector<key_type> keys;
+				for (int32_t i = 0; i < _Ptr->fields.count; i++) {
+					if (_Ptr->fields.entries->vector[i].hashCode >= 0) keys.push_back(_Ptr->fields.entries->vector[i].key);
+				}
+				if (keys.empty()) return result;
+
+				if constexpr (key_hash<key_type>::supported)
+					result.probed = can_probe();
+				for (const auto& key : keys) {
+					if (find_entry(key) != managed_find_entry(key)) result.mismatches++;
+				}
+
+				const auto time = [&](auto lookup) {
+					volatile int32_t sink = 0;
+					auto start = std::chrono::steady_clock::now();
+					for (size_t round = 0; round < rounds; round++)
+						for (const auto& key : keys) sink = sink + lookup(key);
+					return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (rounds * keys.size());
+				};
+				result.lookups = rounds * keys.size();
+				result.direct_ns = time([this](const key_type& key) { return find_entry(key); });
+				result.managed_ns = time([this](const key_type& key) { return managed_find_entry(key); });
+				return result;
+			}
 			constexpr E* get() const { return _Ptr; }
 		protected:
+			// Comparer classes already checked, shared by every dictionary of this type.
+			static inline std::atomic<const Il2CppClass*> _Probed = nullptr;
+			static inline std::atomic<const Il2CppClass*> _Rejected = nullptr;
+
+			bool can_probe() const {
+				auto comparer = reinterpret_cast<Il2CppObject*>(_Ptr->fields.comparer);
+				if (!comparer || !_Ptr->fields.buckets || !_Ptr->fields.entries) return false;
+
+				const Il2CppClass* klass = comparer->klass;
+				if (klass == _Probed.load(std::memory_order_relaxed)) return true;
+				if (klass == _Rejected.load(std::memory_order_relaxed)) return false;
+
+				// Only the BCL's default comparers, and only once a stored hash code proves key_hash right.
+				std::string_view name = klass->name;
+				bool ok = std::string_view(klass->namespaze) == "System.Collections.Generic" && name.ends_with("EqualityComparer`1");
+				int32_t sample = -1;
+				for (int32_t i = 0; ok && sample < 0 && i < _Ptr->fields.count; i++) {
+					if (_Ptr->fields.entries->vector[i].hashCode >= 0) sample = i;
+				}
+				if (ok && sample < 0) return false;	// nothing to verify against yet
+				if (ok) {
+					const auto& entry = _Ptr->fields.entries->vector[sample];
+					ok = (key_hash<key_type>::get(entry.key) & 0x7FFFFFFF) == entry.hashCode;
+				}
+
+				(ok ? _Probed : _Rejected).store(klass, std::memory_order_relaxed);
+				return ok;
+			}
+			// The chain walk is bounded by the entries array and by count steps, so a chain torn
+			// by a resize on another thread ends the lookup instead of reading out of bounds or
+			// looping forever.
+			int32_t probe_entry(const key_type& _Keyval) const {
+				auto buckets = _Ptr->fields.buckets;
+				auto entries = _Ptr->fields.entries;
+				if (buckets->max_length == 0) return -1;
+
+				const auto capacity = static_cast<size_t>(entries->max_length);
+				const int32_t count = _Ptr->fields.count;
+				int32_t hashCode = key_hash<key_type>::get(_Keyval) & 0x7FFFFFFF;
+				int32_t steps = 0;
+				for (int32_t i = buckets->vector[static_cast<size_t>(hashCode) % buckets->max_length]; i >= 0 && static_cast<size_t>(i) < capacity && steps <= count; i = entries->vector[i].next, steps++) {
+					if (entries->vector[i].hashCode == hashCode && entries->vector[i].key == _Keyval) return i;
+				}
+				return -1;
+			}
+
 			E* _Ptr;
 		};
 		template<typename E>
@@ -1,11 +1,73 @@
 #include "pch-il2cpp.h"
 #include "il2cpp-init.h"
+#include <atomic>
+#include <type_traits>
+#include "logger.h"
+
+// Resolve DO_APP_FUNCs on first call instead of in init_il2cpp(). Off by default: a lazy
+// app::X holds the address of its thunk until first called, so a detour on it hooks the thunk
+// and never sees calls from the game, and `if (app::X)` no longer tells whether it resolved.
+// Call bind_app_function(&app::X) (or bind_app_functions()) before hooking or testing it.
+// Without it every DO_APP_FUNC is resolved in init_il2cpp() and unresolved ones are NULL.
+
+// Bind DO_APP_FUNC pointers from the RVAs in il2cpp-rvas.h, generated offline by
+// AppDataGenerator. Every IL2CPP_RVA_CHECK_STRIDE-th entry (all of them in debug builds)
+// is checked against the live metadata first; one mismatch means the header is from another
+// build, nothing is bound from it and every pointer is resolved by signature.
+#if IL2CPP_USE_RVAS && !defined(IL2CPP_RVA_CHECK_STRIDE)
+#if defined(_DEBUG)
+#define IL2CPP_RVA_CHECK_STRIDE 1
+#else
+#define IL2CPP_RVA_CHECK_STRIDE 16
+#endif
+#endif
+
+// Each DO_APP_FUNC pointer starts at its own thunk. bind() resolves the signature once and
+// patches the pointer; with IL2CPP_LAZY_BINDING the first call through the thunk does that and
+// calls through, later calls go straight to the game function. A signature that does not
+// resolve is looked up once, later calls return a value-initialized R.
+template<typename Fn, Fn* Slot, const char* Signature>
+struct lazy_binding;
+
+template<typename R, typename... Args, R(**Slot)(Args...), const char* Signature>
+struct lazy_binding<R(*)(Args...), Slot, Signature> {
+	static bool bind() {
+		// already bound, or left NULL by init_il2cpp()
+		if (const auto current = std::atomic_ref(*Slot).load(std::memory_order_acquire); current != &thunk)
+			return current != NULL;
+
+		static std::atomic<bool> failed = false;
+		if (failed.load(std::memory_order_relaxed)) return false;
+
+		auto method = reinterpret_cast<R(*)(Args...)>(get_method(Signature));
+		if (method == NULL) {
+			if (!failed.exchange(true))
+				STREAM_ERROR("Unable to resolve " << Signature);
+			return false;
+		}
+		std::atomic_ref(*Slot).store(method, std::memory_order_release);
+		return true;
+	}
+
+	static bool matches(uintptr_t address) {
+		return reinterpret_cast<uintptr_t>(get_method(Signature)) == address;
+	}
+
+	static R thunk(Args... args) {
+		if (!bind()) {
+			if constexpr (std::is_void_v<R>) return;
+			else return R{};
+		}
+		return std::atomic_ref(*Slot).load(std::memory_order_acquire)(args...);
+	}
+};
 
 #define DO_API(r, n, p) r (*n) p
 #include "il2cpp-api-functions.h"
 #undef DO_API
 
-#define DO_APP_FUNC(r, n, p, s) r (*n) p
+#define DO_APP_FUNC(r, n, p, s) static constexpr char n ## __Signature[] = s; \
+	r (*n) p = &lazy_binding<decltype(n), &n, n ## __Signature>::thunk
 namespace app {
 	#include "il2cpp-functions.h"
 }
@@ -17,6 +79,27 @@ namespace app {
 }
 #undef DO_APP_CLASS
 
+bool bind_app_function(void* slot)
+{
+	using namespace app;
+
+	#define DO_APP_FUNC(r, n, p, s) if (slot == &n) return lazy_binding<decltype(n), &n, n ## __Signature>::bind()
+	#include "il2cpp-functions.h"
+	#undef DO_APP_FUNC
+	return false;
+}
+
+bool bind_app_functions()
+{
+	using namespace app;
+
+	bool bound = true;
+	#define DO_APP_FUNC(r, n, p, s) if (!lazy_binding<decltype(n), &n, n ## __Signature>::bind()) bound = false
+	#include "il2cpp-functions.h"
+	#undef DO_APP_FUNC
+	return bound;
+}
+
 void init_il2cpp()
 {
 	HMODULE moduleHandle = GetModuleHandleW(L"GameAssembly.dll");
@@ -27,9 +110,29 @@ void init_il2cpp()
 
 	using namespace app;
 
-	#define DO_APP_FUNC(r, n, p, s) n = reinterpret_cast<decltype(n)>(get_method(s))
+#if IL2CPP_USE_RVAS
+	const auto baseAddress = reinterpret_cast<uintptr_t>(moduleHandle);
+	size_t rvaIndex = 0, rvaMismatches = 0;
+	#define DO_APP_RVA(n, rva) if (rvaIndex++ % IL2CPP_RVA_CHECK_STRIDE == 0 && !lazy_binding<decltype(n), &n, n ## __Signature>::matches(baseAddress + rva)) { \
+		STREAM_ERROR("RVA mismatch for " << n ## __Signature); \
+		rvaMismatches++; \
+	}
+	#include "il2cpp-rvas.h"
+	#undef DO_APP_RVA
+
+	if (rvaMismatches == 0) {
+		#define DO_APP_RVA(n, rva) n = reinterpret_cast<decltype(n)>(baseAddress + rva)
+		#include "il2cpp-rvas.h"
+		#undef DO_APP_RVA
+	}
+#endif
+
+#if !IL2CPP_LAZY_BINDING
+	// entries already bound from an RVA are skipped by bind(); unresolved ones end up NULL
+	#define DO_APP_FUNC(r, n, p, s) if (!lazy_binding<decltype(n), &n, n ## __Signature>::bind()) n = NULL
 	#include "il2cpp-functions.h"
 	#undef DO_APP_FUNC
+#endif
 
 	#define DO_APP_CLASS(n, s) n ## __TypeInfo = reinterpret_cast<decltype(n ## __TypeInfo)>(get_class(s))
 	#include "il2cpp-classes.h"
@@ -1,3 +1,9 @@
 #pragma once
 
-void init_il2cpp();
\ No newline at end of file
+void init_il2cpp();
+// Resolve a DO_APP_FUNC now, e.g. bind_app_function(&app::X) before hooking it; only needed with IL2CPP_LAZY_BINDING.
+// False if its signature does not resolve.
+bool bind_app_function(void* slot);
+
+// bind_app_function for every DO_APP_FUNC; false if any did not resolve.
+bool bind_app_functions();
@@ -6,6 +6,16 @@
 #include <string.h>
 #include <ftw.h>
 #include <dlfcn.h>
+#include <link.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
 
 #include "utils.h"
 
@@ -165,34 +175,180 @@ static std::string get_base_name(const std::string& pathname) {
     return pathname; // If no separator was found, return the whole string
 }
 
-std::string get_module_name_and_offset(void* ptr) {
-    Dl_info dl_info;
-    if (dladdr(ptr, &dl_info) == 0) {
-        return "Error: Could not find module for the given pointer.";
+// Module range table for get_module_name_and_offset.
+// One entry per PT_LOAD segment, sorted by start address, published as an
+// immutable snapshot so lookups from hooks on any thread never take a lock.
+// A lookup that falls outside every known segment triggers a rescan (at most
+// once per MODULE_RESCAN_INTERVAL_NS, one at a time), which picks up libraries
+// loaded by dlopen; call refresh_module_ranges() after a dlclose to drop stale
+// ranges. A new snapshot is only published when the module set changed, and a
+// replaced one is freed once no lookup is reading it. Module names are interned
+// for the life of the process, so names handed out stay valid across rescans.
+struct module_table {
+    std::vector<uintptr_t>   starts;
+    std::vector<uintptr_t>   ends;
+    std::vector<uintptr_t>   bases;    // same as Dl_info::dli_fbase
+    std::vector<const char*> names;    // base names, interned in g_module_names
+
+    bool operator==(const module_table& other) const {
+        return starts == other.starts && ends == other.ends && bases == other.bases && names == other.names;
+    }
+};
+
+#define MODULE_RESCAN_INTERVAL_NS (100 * 1000 * 1000LL)
+
+static std::atomic<const module_table*> g_module_table{nullptr};
+static std::atomic<long long>           g_module_table_time{0};
+static std::atomic<int>                 g_module_table_readers{0};
+static std::mutex                       g_module_table_mutex;
+static std::vector<std::unique_ptr<const module_table>> g_module_tables_retired; // freed when no reader is left
+static std::unordered_set<std::string>* g_module_names = new std::unordered_set<std::string>; // never freed, hooks may run during exit
+
+// pins the current snapshot; a snapshot replaced while pinned is freed by a later rescan
+struct module_table_reader {
+    const module_table* table;
+
+    module_table_reader() {
+        g_module_table_readers.fetch_add(1, std::memory_order_seq_cst);
+        table = g_module_table.load(std::memory_order_seq_cst);
     }
+    ~module_table_reader() { g_module_table_readers.fetch_sub(1, std::memory_order_release); }
+};
 
-    // dl_info.dli_fbase gives the base address where the shared object is loaded.
-    uintptr_t base_address = reinterpret_cast<uintptr_t>(dl_info.dli_fbase);
-    // Cast the pointer to uintptr_t before the arithmetic operation for portability.
-    uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
-    uintptr_t offset = address - base_address;
+static long long monotonic_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
 
-    // Check if we have a valid shared object name.
-    std::string module_name = dl_info.dli_fname ? dl_info.dli_fname : "Unknown";
+static int collect_module_ranges(struct dl_phdr_info* info, size_t, void* data) {
+    auto* segments = static_cast<std::vector<std::pair<std::pair<uintptr_t, uintptr_t>, std::pair<uintptr_t, std::string>>>*>(data);
 
-    module_name = get_base_name(module_name);
+    uintptr_t low = UINTPTR_MAX;
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const auto& ph = info->dlpi_phdr[i];
+        if (ph.p_type == PT_LOAD && ph.p_vaddr < low) low = ph.p_vaddr;
+    }
+    if (low == UINTPTR_MAX) return 0;
+    const uintptr_t base = (info->dlpi_addr + low) & ~static_cast<uintptr_t>(getpagesize() - 1);
+
+    std::string name = info->dlpi_name ? info->dlpi_name : "";
+    if (name.empty()) {
+        // the main executable has no name here, dladdr knows it
+        Dl_info dl_info;
+        name = dladdr(reinterpret_cast<void*>(info->dlpi_addr + low), &dl_info) && dl_info.dli_fname ? dl_info.dli_fname : "Unknown";
+    }
+    name = get_base_name(name);
+
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const auto& ph = info->dlpi_phdr[i];
+        if (ph.p_type != PT_LOAD || ph.p_memsz == 0) continue;
+        const uintptr_t start = info->dlpi_addr + ph.p_vaddr;
+        segments->push_back({{start, start + ph.p_memsz}, {base, name}});
+    }
+    return 0;
+}
+
+// rescans unless a rescan finished less than MODULE_RESCAN_INTERVAL_NS ago; true if it did
+static bool rescan_module_ranges(bool force) {
+    std::lock_guard<std::mutex> lock(g_module_table_mutex);
+    const module_table* current = g_module_table.load(std::memory_order_relaxed);
+    if (!force && current && monotonic_ns() - g_module_table_time.load(std::memory_order_relaxed) < MODULE_RESCAN_INTERVAL_NS) return false;
+
+    std::vector<std::pair<std::pair<uintptr_t, uintptr_t>, std::pair<uintptr_t, std::string>>> segments;
+    dl_iterate_phdr(collect_module_ranges, &segments);
+    std::sort(segments.begin(), segments.end());
+
+    std::unique_ptr<module_table> table(new module_table);
+    for (auto& segment : segments) {
+        table->starts.push_back(segment.first.first);
+        table->ends.push_back(segment.first.second);
+        table->bases.push_back(segment.second.first);
+        table->names.push_back(g_module_names->insert(std::move(segment.second.second)).first->c_str());
+    }
+
+    if (!current || !(*table == *current)) {
+        g_module_table.store(table.release(), std::memory_order_seq_cst);
+        if (current) g_module_tables_retired.emplace_back(current);
+    }
+    // readers that pinned before the store may hold a retired table, later ones see the new one
+    if (!g_module_tables_retired.empty() && g_module_table_readers.load(std::memory_order_seq_cst) == 0)
+        g_module_tables_retired.clear();
+    g_module_table_time.store(monotonic_ns(), std::memory_order_relaxed);
+    return true;
+}
+
+void refresh_module_ranges() {
+    rescan_module_ranges(true);
+}
+
+// index of the last segment starting at or below address, -1 if none
+static long find_segment(const module_table* table, uintptr_t address) {
+    const size_t count = table->starts.size();
+    if (count == 0 || address < table->starts[0]) return -1;
+    const uintptr_t* base = table->starts.data();
+    size_t n = count;
+    while (n > 1) {
+        const size_t half = n / 2;
+        base = base[half] <= address ? base + half : base;
+        n -= half;
+    }
+    const long index = base - table->starts.data();
+    return address < table->ends[index] ? index : -1;
+}
+
+// looks address up, rescanning once on a miss
+template<typename F>
+static bool with_segment(uintptr_t address, F&& f) {
+    for (int attempt = 0; attempt < 2; attempt++) {
+        {
+            module_table_reader reader;
+            const long index = reader.table ? find_segment(reader.table, address) : -1;
+            if (index >= 0) {
+                f(reader.table, index);
+                return true;
+            }
+        }
+        if (attempt == 0 && !rescan_module_ranges(false)) return false;
+    }
+    return false;
+}
+
+bool find_module_and_offset(void* ptr, const char** name, uintptr_t* offset) {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    return with_segment(address, [&](const module_table* table, long index) {
+        if (name) *name = table->names[index];
+        if (offset) *offset = address - table->bases[index];
+    });
+}
+
+bool find_module_segment(void* ptr, uintptr_t* start, uintptr_t* end) {
+    return with_segment(reinterpret_cast<uintptr_t>(ptr), [&](const module_table* table, long index) {
+        if (start) *start = table->starts[index];
+        if (end) *end = table->ends[index];
+    });
+}
+
+int format_module_name_and_offset(void* ptr, char* buf, size_t len) {
+    const char* module_name;
+    uintptr_t offset;
+    if (!find_module_and_offset(ptr, &module_name, &offset)) return -1;
 
-    // Convert the offset to a string in hexadecimal form.
-    char offset_str[32];
 #if defined(__aarch64__)
-    snprintf(offset_str, sizeof(offset_str), "0x%jx 0x%jx", static_cast<uintmax_t>(offset), static_cast<uintmax_t>(offset+0x100000));
+    return snprintf(buf, len, "%s@0x%jx 0x%jx", module_name, static_cast<uintmax_t>(offset), static_cast<uintmax_t>(offset+0x100000));
 #elif defined(__arm__)
-    snprintf(offset_str, sizeof(offset_str), "0x%jx 0x%jx", static_cast<uintmax_t>(offset), static_cast<uintmax_t>(offset+0x1000));
+    return snprintf(buf, len, "%s@0x%jx 0x%jx", module_name, static_cast<uintmax_t>(offset), static_cast<uintmax_t>(offset+0x1000));
 #else
-    snprintf(offset_str, sizeof(offset_str), "0x%jx", static_cast<uintmax_t>(offset));
+    return snprintf(buf, len, "%s@0x%jx", module_name, static_cast<uintmax_t>(offset));
 #endif
+}
 
-    return module_name + "@" + offset_str;
+std::string get_module_name_and_offset(void* ptr) {
+    char buf[PATH_MAX + 64];
+    if (format_module_name_and_offset(ptr, buf, sizeof(buf)) < 0) {
+        return "Error: Could not find module for the given pointer.";
+    }
+    return buf;
 }
 
 
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <stdio.h>
+#include <stdint.h>
 #include <string>
 
 extern "C" void _frida_log(const char* message);
@@ -35,6 +36,13 @@ int base64_encode(const unsigned char *in, int in_len, char *out, int out_len) ;
 #endif
 
 std::string get_module_name_and_offset(void* ptr) ;
+// allocation-free variants of get_module_name_and_offset; -1 / false if ptr is in no loaded module
+int format_module_name_and_offset(void* ptr, char* buf, size_t len) ;
+bool find_module_and_offset(void* ptr, const char** name, uintptr_t* offset) ;
+// bounds of the loaded segment containing ptr
+bool find_module_segment(void* ptr, uintptr_t* start, uintptr_t* end) ;
+// rescan loaded modules, e.g. after dlclose
+void refresh_module_ranges() ;
 std::string utf16_to_utf8(const std::u16string& utf16_str) ;
 std::string utf16_to_utf8(const char16_t* utf16_str, int length) ;
 